@@ -1,77 +1,563 @@
-#include <iostream> // For standard input/output
+#include <iostream>     // For standard input/output
+#include <functional>   // For less<> (default comparator)
+#include <queue>        // For level-order height computation
+#include <stack>        // For iterative mirror and deletion
+#include <future>       // For async (fork-join over subtrees)
+#include <thread>       // For hardware_concurrency
+#include <chrono>       // For timing the benchmark
+#include <random>       // For random benchmark keys
+#include <cstdint>      // For uint64_t in the checksum mix
+#include <utility>      // For pair
+#include <vector>       // For the frozen (array) layout
+#include <cmath>        // For log2 in the height check
+#include <memory>       // For unique_ptr result arrays
+#include <algorithm>    // For min and equal
 using namespace std;
 
 // Node structure for the BST
+template <class Key>
 class Node {
 public:
-    int data;       // Stores the value of the node
-    Node* left;     // Pointer to left child
-    Node* right;    // Pointer to right child
+    Key data;           // Stores the value of the node
+    Node* left;         // Pointer to left child
+    Node* right;        // Pointer to right child
+    uint32_t priority;  // Random heap priority (used in treap mode)
 
-    Node(int val) {         // Constructor to initialize node
+    Node(const Key& val, uint32_t pri = 0) {  // Constructor to initialize node
         data = val;         // Assign the value
         left = NULL;        // Initially left child is null
         right = NULL;       // Initially right child is null
+        priority = pri;     // Parent priority >= child priority in a treap
     }
 };
 
-// Function to insert a node into BST
-Node* insert(Node* root, int val) {
-    if (root == NULL)                 // If tree is empty, create a new node as root
-        return new Node(val);
-    if (val < root->data)             // If value is less, go to left subtree
-        root->left = insert(root->left, val);
-    else                              // If value is greater or equal, go to right subtree
-        root->right = insert(root->right, val);
-    return root;                      // Return the root (unchanged)
+// Hint the CPU to start loading the cache line at p (no-op elsewhere)
+inline void prefetch(const void* p) {
+#if defined(__GNUC__)
+    __builtin_prefetch(p);
+#else
+    (void)p;
+#endif
 }
 
-// Function to calculate the height / longest path from root
-int longestPath(Node* root) {
-    if (root == NULL) return 0;             // Base case: empty tree has 0 height
-    int left = longestPath(root->left);     // Recursively find height of left subtree
-    int right = longestPath(root->right);   // Recursively find height of right subtree
-    return max(left, right) + 1;            // Height is max of left/right + current node
+// Summary of a whole (sub)tree, computed in one pass
+template <class Key>
+struct TreeSummary {
+    size_t count = 0;       // Number of nodes
+    int height = 0;         // Longest root-to-leaf path (in nodes)
+    Key min = Key();        // Smallest key (valid when count > 0)
+    Key max = Key();        // Largest key (valid when count > 0)
+    size_t checksum = 0;    // Order-independent hash of all keys
+};
+
+// Spread the bits of a key hash so that summing them is a good checksum
+inline size_t mixHash(size_t h) {
+    uint64_t z = h + 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return (size_t)(z ^ (z >> 31));
+}
+
+// Read-only BST stored as an array in Eytzinger (BFS) order: the children of
+// slot k are slots 2k and 2k+1. The top levels of the tree share a few cache
+// lines, descendants several levels down are prefetched before they are
+// needed, and the descent has no unpredictable branch.
+template <class Key, class Compare = less<Key>>
+class FrozenBST {
+    vector<Key> a;          // a[1..n] in BFS order (a[0] unused)
+    Compare comp;
+
+public:
+    // Build from keys already sorted by comp (duplicates allowed)
+    FrozenBST(const vector<Key>& sorted, Compare c = Compare()) : a(sorted.size() + 1), comp(c) {
+        size_t n = sorted.size(), i = 0, k = 1;
+        stack<size_t> st;                   // In-order walk of the implicit tree
+        while (true) {
+            while (k <= n) {
+                st.push(k);
+                k = 2 * k;
+            }
+            if (st.empty()) break;
+            k = st.top(); st.pop();
+            a[k] = sorted[i++];             // In-order position gets next sorted key
+            k = 2 * k + 1;
+        }
+    }
+
+    size_t size() const { return a.size() - 1; }
+
+    // Search a value: descend to the first key not less than val, then test it
+    bool search(const Key& val) const {
+        const size_t n = a.size() - 1;
+        // Slots 4 levels below hold 16x the index: prefetching a[16k] brings
+        // in the cache line of all 16 great-great-grandchildren of k at once
+        const size_t ahead = sizeof(Key) <= 4 ? 16 : sizeof(Key) <= 8 ? 8 : 4;
+        const Key* data = a.data();
+        size_t k = 1;
+        while (k <= n) {
+#if defined(__GNUC__)
+            if (ahead * k <= n) __builtin_prefetch(data + ahead * k);
+#endif
+            k = 2 * k + comp(data[k], val); // Left if a[k] >= val, right otherwise
+        }
+        // Undo the trailing right turns plus the last left turn: what remains
+        // is the last node where we went left, i.e. the first key >= val
+        k >>= __builtin_ffsll(~k);
+        return k != 0 && !comp(val, data[k]);
+    }
+};
+
+// Binary search tree over any key type ordered by Compare.
+// Every operation is iterative, so a degenerate (sorted input) tree with
+// millions of levels cannot overflow the call stack.
+// In treap mode every node also gets a random priority and the tree is kept
+// heap-ordered on it, which gives expected O(log n) height for any input.
+template <class Key, class Compare = less<Key>>
+class BST {
+    Node<Key>* root;    // Root of the tree
+    Compare comp;       // Strict weak ordering on keys
+    bool mirrored;      // True after an odd number of swapNodes() calls
+    bool treap;         // Keep the tree balanced with random priorities
+    mt19937 rng;        // Source of treap priorities
+
+    // Split subtree t into l (keys before val) and r (keys after val);
+    // keys equal to val go to l if equalsLeft, else to r. Iterative.
+    void split(Node<Key>* t, const Key& val, bool equalsLeft, Node<Key>*& l, Node<Key>*& r) const {
+        Node<Key>** lLink = &l;             // Where the next "left" node hangs
+        Node<Key>** rLink = &r;             // Where the next "right" node hangs
+        while (t != NULL) {
+            bool toRight = equalsLeft ? goesLeft(val, t->data) : !goesLeft(t->data, val);
+            if (toRight) {
+                *rLink = t;                 // t and its right subtree belong to r
+                rLink = &t->left;
+                t = t->left;
+            } else {
+                *lLink = t;                 // t and its left subtree belong to l
+                lLink = &t->right;
+                t = t->right;
+            }
+        }
+        *lLink = *rLink = NULL;
+    }
+
+    // Join two treaps where every key of l comes before every key of r
+    static Node<Key>* merge(Node<Key>* l, Node<Key>* r) {
+        Node<Key>* result = NULL;
+        Node<Key>** link = &result;
+        while (l != NULL && r != NULL) {
+            if (l->priority > r->priority) {  // l's root stays on top
+                *link = l;
+                link = &l->right;
+                l = l->right;
+            } else {                          // r's root stays on top
+                *link = r;
+                link = &r->left;
+                r = r->left;
+            }
+        }
+        *link = (l != NULL) ? l : r;
+        return result;
+    }
+
+    // Union of two treaps: the root with the higher priority stays on top and
+    // the other treap is split around its key. Recursion depth is bounded by
+    // the (expected logarithmic) treap heights.
+    Node<Key>* unite(Node<Key>* a, Node<Key>* b) {
+        if (a == NULL) return b;
+        if (b == NULL) return a;
+        if (a->priority < b->priority) swap(a, b);
+        Node<Key>* l;
+        Node<Key>* r;
+        split(b, a->data, false, l, r);     // Equal keys go right, as in insert
+        a->left = unite(a->left, l);
+        a->right = unite(a->right, r);
+        return a;
+    }
+
+    // "a goes to the left of b" taking the current mirroring into account
+    bool goesLeft(const Key& a, const Key& b) const {
+        return mirrored ? comp(b, a) : comp(a, b);
+    }
+
+    // Number of fork levels for the given thread count: about 4 tasks per
+    // thread, so unevenly sized subtrees still keep every core busy
+    static int spawnDepth(unsigned threads) {
+        int depth = 0;
+        while (threads > 1 && (1u << depth) < threads * 4) depth++;
+        return depth;
+    }
+
+    // Sequential summary of one subtree (explicit stack of node + depth)
+    TreeSummary<Key> summarizeSequential(Node<Key>* node) const {
+        TreeSummary<Key> s;
+        stack<pair<Node<Key>*, int>> st;
+        if (node != NULL) st.push(make_pair(node, 1));
+        while (!st.empty()) {
+            Node<Key>* curr = st.top().first;
+            int depth = st.top().second;
+            st.pop();
+            if (s.count == 0 || comp(curr->data, s.min)) s.min = curr->data;
+            if (s.count == 0 || comp(s.max, curr->data)) s.max = curr->data;
+            s.count++;
+            if (depth > s.height) s.height = depth;
+            s.checksum += mixHash(hash<Key>()(curr->data));
+            if (curr->left) st.push(make_pair(curr->left, depth + 1));
+            if (curr->right) st.push(make_pair(curr->right, depth + 1));
+        }
+        return s;
+    }
+
+    // Fork-join summary: the left subtree runs as a separate task while this
+    // thread handles the right one; below `depth` fork levels it is sequential
+    TreeSummary<Key> summarize(Node<Key>* node, int depth) const {
+        if (node == NULL || depth == 0) return summarizeSequential(node);
+        future<TreeSummary<Key>> leftTask;
+        if (node->left)
+            leftTask = async(launch::async, [=] { return summarize(node->left, depth - 1); });
+        TreeSummary<Key> r = summarize(node->right, depth - 1);
+        TreeSummary<Key> l = node->left ? leftTask.get() : TreeSummary<Key>();
+
+        TreeSummary<Key> s;                 // Combine both halves with this node
+        s.count = l.count + r.count + 1;
+        s.height = max(l.height, r.height) + 1;
+        s.min = s.max = node->data;
+        if (l.count && comp(l.min, s.min)) s.min = l.min;
+        if (r.count && comp(r.min, s.min)) s.min = r.min;
+        if (l.count && comp(s.max, l.max)) s.max = l.max;
+        if (r.count && comp(s.max, r.max)) s.max = r.max;
+        s.checksum = l.checksum + r.checksum + mixHash(hash<Key>()(node->data));
+        return s;
+    }
+
+    // Sequential mirror of one subtree
+    static void mirrorSequential(Node<Key>* node) {
+        stack<Node<Key>*> st;
+        if (node != NULL) st.push(node);
+        while (!st.empty()) {
+            Node<Key>* curr = st.top(); st.pop();
+            swap(curr->left, curr->right);
+            if (curr->left) st.push(curr->left);
+            if (curr->right) st.push(curr->right);
+        }
+    }
+
+    // Fork-join mirror, same task structure as summarize()
+    static void mirror(Node<Key>* node, int depth) {
+        if (node == NULL || depth == 0) {
+            mirrorSequential(node);
+            return;
+        }
+        swap(node->left, node->right);
+        future<void> leftTask;
+        if (node->left) leftTask = async(launch::async, [=] { mirror(node->left, depth - 1); });
+        mirror(node->right, depth - 1);
+        if (node->left) leftTask.get();
+    }
+
+public:
+    BST(bool useTreap = false, Compare c = Compare())
+        : root(NULL), comp(c), mirrored(false), treap(useTreap), rng(random_device()()) {}
+    BST(const BST&) = delete;               // Nodes are owned; no shallow copies
+    BST& operator=(const BST&) = delete;
+
+    ~BST() {
+        stack<Node<Key>*> st;               // Free nodes without recursion
+        if (root != NULL) st.push(root);
+        while (!st.empty()) {
+            Node<Key>* curr = st.top(); st.pop();
+            if (curr->left) st.push(curr->left);
+            if (curr->right) st.push(curr->right);
+            delete curr;
+        }
+    }
+
+    bool isTreap() const { return treap; }
+
+    // Insert a value (smaller goes left, greater or equal goes right)
+    void insert(const Key& val) {
+        Node<Key>* node = new Node<Key>(val, rng());
+        Node<Key>** link = &root;           // Link that will point to the new node
+        // Treap: stop at the first node with a lower priority; that subtree is
+        // split around val and hung below the new node
+        while (*link != NULL && (!treap || (*link)->priority >= node->priority))
+            link = goesLeft(val, (*link)->data) ? &(*link)->left : &(*link)->right;
+        if (treap) split(*link, val, true, node->left, node->right);
+        *link = node;
+    }
+
+    // Search many values at once: out[i] = search(keys[i]).
+    // Up to BATCH_GROUP lookups are in flight and are advanced one level each
+    // in round-robin order; each step prefetches the next node of its lookup,
+    // so while one lookup waits for memory the others do useful work.
+    static const int BATCH_GROUP = 16;
+
+    void searchBatch(const Key* keys, size_t count, bool* out) const {
+        Node<Key>* cur[BATCH_GROUP];        // Current node of each in-flight lookup
+        size_t idx[BATCH_GROUP];            // Which key each slot is looking up
+        size_t next = 0;
+        int active = 0;
+        while (active < BATCH_GROUP && next < count) {
+            cur[active] = root;
+            idx[active++] = next++;
+        }
+        prefetch(root);
+
+        while (active > 0) {
+            for (int slot = 0; slot < active; ) {
+                Node<Key>* node = cur[slot];
+                const Key& val = keys[idx[slot]];
+                bool done = true, found = false;
+                if (node == NULL) {
+                    found = false;          // Fell off the tree
+                } else if (goesLeft(val, node->data)) {
+                    cur[slot] = node->left;
+                    done = false;
+                } else if (goesLeft(node->data, val)) {
+                    cur[slot] = node->right;
+                    done = false;
+                } else {
+                    found = true;
+                }
+                if (done) {
+                    out[idx[slot]] = found;
+                    if (next < count) {     // Reuse the slot for the next key
+                        cur[slot] = root;
+                        idx[slot] = next++;
+                    } else {                // No keys left: shrink the group
+                        active--;
+                        cur[slot] = cur[active];
+                        idx[slot] = idx[active];
+                        continue;           // Process the moved lookup in this slot
+                    }
+                }
+                prefetch(cur[slot]);
+                slot++;
+            }
+        }
+    }
+
+    // Delete one occurrence of a value; false if not present.
+    // The node is replaced by the merge of its two subtrees.
+    bool remove(const Key& val) {
+        Node<Key>** link = &root;
+        while (*link != NULL) {
+            Node<Key>* curr = *link;
+            if (goesLeft(val, curr->data)) link = &curr->left;
+            else if (goesLeft(curr->data, val)) link = &curr->right;
+            else {
+                *link = merge(curr->left, curr->right);
+                delete curr;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Move every value of other into this tree (other becomes empty).
+    // Two treaps are combined with split-based union in expected
+    // O(m log(n/m + 1)); otherwise the nodes are re-inserted one by one.
+    void unite(BST& other) {
+        if (other.mirrored != mirrored) other.swapNodes();   // Same orientation
+        if (treap && other.treap) {
+            root = unite(root, other.root);
+        } else {
+            stack<Node<Key>*> st;
+            if (other.root != NULL) st.push(other.root);
+            while (!st.empty()) {
+                Node<Key>* curr = st.top(); st.pop();
+                if (curr->left) st.push(curr->left);
+                if (curr->right) st.push(curr->right);
+                insert(curr->data);
+                delete curr;
+            }
+        }
+        other.root = NULL;
+    }
+
+    // Height / longest path from root, counted level by level
+    int longestPath() const {
+        int height = 0;
+        queue<Node<Key>*> q;
+        if (root != NULL) q.push(root);
+        while (!q.empty()) {
+            height++;                       // One more level
+            for (size_t size = q.size(); size > 0; size--) {
+                Node<Key>* curr = q.front(); q.pop();
+                if (curr->left) q.push(curr->left);
+                if (curr->right) q.push(curr->right);
+            }
+        }
+        return height;
+    }
+
+    // Minimum value (leftmost node, or rightmost once mirrored); false if empty
+    bool findMin(Key& out) const {
+        Node<Key>* curr = root;
+        if (curr == NULL) return false;
+        while ((mirrored ? curr->right : curr->left) != NULL)
+            curr = mirrored ? curr->right : curr->left;
+        out = curr->data;
+        return true;
+    }
+
+    // Swap left and right pointers of every node (mirror the tree),
+    // splitting the work over subtrees when more than one thread is given
+    void swapNodes(unsigned threads = 1) {
+        mirror(root, spawnDepth(threads));
+        mirrored = !mirrored;               // Keep search/insert consistent with the new order
+    }
+
+    // Count, height, min, max and checksum of the whole tree in one pass,
+    // run as fork-join tasks over subtrees when more than one thread is given
+    TreeSummary<Key> summary(unsigned threads = 1) const {
+        return summarize(root, spawnDepth(threads));
+    }
+
+    // Copy the keys into a read-only array layout for lookup-heavy phases.
+    // The tree itself is untouched; later inserts are not seen by the view.
+    FrozenBST<Key, Compare> freeze() const {
+        vector<Key> sorted;
+        stack<Node<Key>*> st;               // Iterative in-order walk
+        Node<Key>* curr = root;
+        while (curr != NULL || !st.empty()) {
+            while (curr != NULL) {
+                st.push(curr);
+                curr = mirrored ? curr->right : curr->left;
+            }
+            curr = st.top(); st.pop();
+            sorted.push_back(curr->data);   // Ascending order by comp
+            curr = mirrored ? curr->left : curr->right;
+        }
+        return FrozenBST<Key, Compare>(sorted, comp);
+    }
+
+    // Search a value
+    bool search(const Key& val) const {
+        Node<Key>* curr = root;
+        while (curr != NULL) {
+            if (goesLeft(val, curr->data)) curr = curr->left;
+            else if (goesLeft(curr->data, val)) curr = curr->right;
+            else return true;               // Neither smaller nor greater: found
+        }
+        return false;
+    }
+};
+
+// Benchmark: build a tree of n random keys, then time the whole-tree summary
+// and mirror with 1, 2, 4, ... threads up to the number of hardware threads
+void benchmark(int n) {
+    typedef chrono::steady_clock clock;
+    auto ms = [](clock::duration d) { return chrono::duration<double, milli>(d).count(); };
+    BST<int> tree;
+    mt19937 rng(7);
+    for (int i = 0; i < n; i++) tree.insert(rng());
+
+    unsigned hw = thread::hardware_concurrency();
+    if (hw == 0) hw = 1;
+    double base[2] = {0, 0};
+    cout << "Nodes: " << n << ", hardware threads: " << hw << "\n";
+    for (unsigned threads = 1; ; threads = min(threads * 2, hw)) {
+        auto s = clock::now();
+        TreeSummary<int> sum = tree.summary(threads);
+        double summaryMs = ms(clock::now() - s);
+        s = clock::now();
+        tree.swapNodes(threads);
+        double mirrorMs = ms(clock::now() - s);
+        if (threads == 1) {
+            base[0] = summaryMs;
+            base[1] = mirrorMs;
+        }
+        cout << "  " << threads << " thread(s): summary " << summaryMs << " ms (x" << base[0] / summaryMs
+             << "), mirror " << mirrorMs << " ms (x" << base[1] / mirrorMs << "), height "
+             << sum.height << ", checksum " << sum.checksum << "\n";
+        if (threads == hw) break;
+    }
 }
 
-// Function to find the minimum value node in BST
-int findMin(Node* root) {
-    if (root == NULL) return -1;            // If tree is empty
-    while (root->left != NULL)              // Keep going left
-        root = root->left;
-    return root->data;                      // Leftmost node is the minimum
+// Benchmark: lookups on the pointer tree vs. its frozen Eytzinger copy
+void benchmarkFrozen(int n, int lookups) {
+    typedef chrono::steady_clock clock;
+    auto ms = [](clock::duration d) { return chrono::duration<double, milli>(d).count(); };
+    BST<int> tree;
+    mt19937 rng(11);
+    for (int i = 0; i < n; i++) tree.insert(rng() % (2u * n));   // About half the queries hit
+
+    auto s = clock::now();
+    FrozenBST<int> frozen = tree.freeze();
+    double freezeMs = ms(clock::now() - s);
+
+    vector<int> queries(lookups);
+    for (int i = 0; i < lookups; i++) queries[i] = rng() % (2u * n);
+
+    long long hitsTree = 0, hitsFrozen = 0;
+    s = clock::now();
+    for (int q : queries) hitsTree += tree.search(q);
+    double treeMs = ms(clock::now() - s);
+    s = clock::now();
+    for (int q : queries) hitsFrozen += frozen.search(q);
+    double frozenMs = ms(clock::now() - s);
+
+    cout << "Nodes: " << n << ", freeze: " << freezeMs << " ms, lookups: " << lookups
+         << " (hits " << hitsTree << " / " << hitsFrozen << ")\n";
+    cout << "  Pointer tree : " << lookups / treeMs / 1000 << " M lookups/s\n";
+    cout << "  Eytzinger    : " << lookups / frozenMs / 1000 << " M lookups/s (x" << treeMs / frozenMs << ")\n";
 }
 
-// Function to swap left and right pointers (mirror the tree)
-void swapNodes(Node* root) {
-    if (root == NULL) return;               // Base case
-    swap(root->left, root->right);          // Swap left and right pointers
-    swapNodes(root->left);                  // Recursively swap left subtree
-    swapNodes(root->right);                 // Recursively swap right subtree
+// Benchmark: lookups in batches of `batch` keys, searchBatch vs. repeated search
+void benchmarkBatch(int n, int lookups, int batch) {
+    typedef chrono::steady_clock clock;
+    auto ms = [](clock::duration d) { return chrono::duration<double, milli>(d).count(); };
+    BST<int> tree;
+    mt19937 rng(13);
+    for (int i = 0; i < n; i++) tree.insert(rng() % (2u * n));   // About half the queries hit
+
+    vector<int> queries(lookups);
+    for (int i = 0; i < lookups; i++) queries[i] = rng() % (2u * n);
+    unique_ptr<bool[]> single(new bool[lookups]), batched(new bool[lookups]);
+
+    auto s = clock::now();
+    for (int i = 0; i < lookups; i++) single[i] = tree.search(queries[i]);
+    double singleMs = ms(clock::now() - s);
+    s = clock::now();
+    for (int i = 0; i < lookups; i += batch)
+        tree.searchBatch(&queries[i], min(batch, lookups - i), &batched[i]);
+    double batchMs = ms(clock::now() - s);
+
+    bool same = equal(single.get(), single.get() + lookups, batched.get());
+    cout << "Nodes: " << n << ", lookups: " << lookups << ", batch size: " << batch
+         << (same ? " (results match)" : " (RESULTS DIFFER)") << "\n";
+    cout << "  search      : " << lookups / singleMs / 1000 << " M lookups/s\n";
+    cout << "  searchBatch : " << lookups / batchMs / 1000 << " M lookups/s (x" << singleMs / batchMs << ")\n";
 }
 
-// Function to search a value in BST
-bool search(Node* root, int val) {
-    if (root == NULL) return false;         // If tree is empty, return false
-    if (val == root->data) return true;     // Value found
-    if (val < root->data)                   // If value is less, search left
-        return search(root->left, val);
-    else                                    // Else, search right
-        return search(root->right, val);
+// Check: insert 1..n in sorted order into a treap and compare its height
+// with log2(n). A plain BST would have height n for the same input.
+void sortedHeightCheck(int n) {
+    BST<int> treap(true);
+    for (int i = 1; i <= n; i++) treap.insert(i);
+    int height = treap.longestPath();
+    double lg = log2((double)n + 1);
+    bool ok = height <= 4 * lg + 4;       // Expected ~3 log2 n; far below n
+    cout << "Sorted inserts: " << n << ", treap height: " << height << ", log2(n): " << lg
+         << ", plain BST height would be " << n << "\n";
+    cout << (ok ? "PASS" : "FAIL") << ": height is " << (ok ? "" : "not ") << "O(log n)\n";
 }
 
 // Main function
 int main() {
-    Node* root = NULL;                      // Start with an empty tree
     int choice, val;                        // For menu input
 
+    cout << "Balance the tree as a treap? (1 = yes, 0 = plain BST): ";
+    cin >> choice;
+    BST<int> tree(choice == 1);             // Start with an empty tree
+
     int n;                                  // Number of initial nodes
     cout << "Enter number of initial nodes to insert: ";
     cin >> n;                               // Read number of nodes
     cout << "Enter " << n << " values:\n";
     for (int i = 0; i < n; ++i) {           // Insert initial values into BST
         cin >> val;
-        root = insert(root, val);
+        tree.insert(val);
     }
 
     // Menu loop for user operations
@@ -82,7 +568,14 @@ int main() {
         cout << "3. Find minimum value in tree\n";
         cout << "4. Swap left and right pointers\n";
         cout << "5. Search a value\n";
-        cout << "6. Exit\n";
+        cout << "6. Whole-tree summary (parallel)\n";
+        cout << "7. Benchmark parallel whole-tree operations\n";
+        cout << "8. Benchmark frozen (Eytzinger) vs pointer search\n";
+        cout << "9. Delete a value\n";
+        cout << "10. Union with another set of values\n";
+        cout << "11. Check treap height under sorted inserts\n";
+        cout << "12. Benchmark batch search\n";
+        cout << "13. Exit\n";
         cout << "Enter your choice: ";
         cin >> choice;                      // Read user choice
 
@@ -90,33 +583,95 @@ int main() {
             case 1:
                 cout << "Enter value to insert: ";
                 cin >> val;                 // Get value from user
-                root = insert(root, val);   // Insert value into tree
+                tree.insert(val);           // Insert value into tree
                 cout << "Node inserted.\n";
                 break;
 
             case 2:
-                cout << "Longest path (tree height): " << longestPath(root) << "\n";
+                cout << "Longest path (tree height): " << tree.longestPath() << "\n";
                 break;
 
             case 3:
-                cout << "Minimum value: " << findMin(root) << "\n";
+                if (tree.findMin(val))
+                    cout << "Minimum value: " << val << "\n";
+                else
+                    cout << "Tree is empty.\n";
                 break;
 
             case 4:
-                swapNodes(root);            // Mirror the tree
+                tree.swapNodes();           // Mirror the tree
                 cout << "Tree has been mirrored.\n";
                 break;
 
             case 5:
                 cout << "Enter value to search: ";
                 cin >> val;                 // Get value to search
-                if (search(root, val))      // Search and print result
+                if (tree.search(val))       // Search and print result
                     cout << "Value found in the tree.\n";
                 else
                     cout << "Value NOT found.\n";
                 break;
 
-            case 6:
+            case 6: {
+                unsigned threads = thread::hardware_concurrency();
+                TreeSummary<int> s = tree.summary(threads ? threads : 1);
+                cout << "Nodes: " << s.count << ", height: " << s.height;
+                if (s.count) cout << ", min: " << s.min << ", max: " << s.max;
+                cout << ", checksum: " << s.checksum << "\n";
+                break;
+            }
+
+            case 7:
+                cout << "Enter number of random nodes (e.g. 10000000): ";
+                cin >> val;
+                if (val > 0) benchmark(val);
+                break;
+
+            case 8: {
+                int lookups;
+                cout << "Enter number of random nodes and number of lookups: ";
+                cin >> val >> lookups;
+                if (val > 0 && lookups > 0) benchmarkFrozen(val, lookups);
+                break;
+            }
+
+            case 9:
+                cout << "Enter value to delete: ";
+                cin >> val;
+                if (tree.remove(val)) cout << "Value deleted.\n";
+                else cout << "Value NOT found.\n";
+                break;
+
+            case 10: {
+                BST<int> other(tree.isTreap());  // Second tree in the same mode
+                int count;
+                cout << "Enter number of values in the other set: ";
+                cin >> count;
+                cout << "Enter " << count << " values:\n";
+                for (int i = 0; i < count; i++) {
+                    cin >> val;
+                    other.insert(val);
+                }
+                tree.unite(other);
+                cout << "Sets merged.\n";
+                break;
+            }
+
+            case 11:
+                cout << "Enter number of sorted values to insert (e.g. 1000000): ";
+                cin >> val;
+                if (val > 0) sortedHeightCheck(val);
+                break;
+
+            case 12: {
+                int lookups, batch;
+                cout << "Enter number of random nodes, number of lookups and batch size: ";
+                cin >> val >> lookups >> batch;
+                if (val > 0 && lookups > 0 && batch > 0) benchmarkBatch(val, lookups, batch);
+                break;
+            }
+
+            case 13:
                 cout << "Exiting program.\n";
                 return 0;                   // Exit the program
 
@@ -137,19 +692,82 @@ Concepts Used:
 1. Binary Search Tree (BST):
    - A tree where each node has at most two children.
    - Left child < parent, Right child >= parent.
+   - Implemented as a class template BST<Key, Compare>, so it works for any
+     key type with a strict weak ordering (default: operator< via less<Key>).
 
 2. Insert:
-   - Recursive approach to find correct location and insert the new node.
+   - Iterative: walk down keeping a pointer to the link (left/right field)
+     where the new node must be attached.
 
 3. Longest Path:
-   - Uses recursion to find the height (max depth) of left and right subtrees.
+   - Level-order traversal with a queue; the number of levels is the height.
+   - No recursion, so even a 1M-deep chain from sorted input is fine.
 
 4. Find Minimum:
    - Leftmost node in a BST always holds the minimum value.
 
 5. Swap Nodes:
-   - Recursively swaps left and right children of all nodes — produces a mirror image.
+   - Swaps left and right children of all nodes using an explicit stack —
+     produces a mirror image.
+   - The tree remembers that it is mirrored, so search, insert and find
+     minimum keep working on the reversed order.
 
 6. Search:
-   - Standard binary search logic applied to tree structure.
+   - Standard binary search logic applied to tree structure, in a loop.
+
+7. Memory:
+   - The destructor frees all nodes with an explicit stack (no recursion).
+
+8. Parallel whole-tree operations (fork-join):
+   - summary() computes count, height, min, max and an order-independent
+     checksum in one pass; swapNodes() mirrors the tree.
+   - With T threads the top ~log2(4T) levels fork: the left subtree becomes
+     an async task while the current thread takes the right one, then the
+     results are joined (combined) at the parent.
+   - Below that cutoff each task walks its subtree sequentially with an
+     explicit stack, so task overhead is paid only a few dozen times.
+   - Speedup depends on balance: a random tree splits evenly, a degenerate
+     chain cannot be split and runs at sequential speed.
+   - Menu option 7 reports the speedup for 1, 2, 4, ... threads.
+   - Compile with -pthread (e.g. g++ -O2 -pthread "3. Empty BST.cpp").
+
+9. Frozen (Eytzinger) layout:
+   - freeze() copies the keys in sorted order into an array laid out in
+     BFS order (children of slot k at 2k and 2k+1) and returns a read-only
+     FrozenBST that supports search().
+   - The first levels of every search hit the same few cache lines, and
+     the loop prefetches the line holding the node 4 levels further down,
+     so memory latency overlaps with the comparisons.
+   - The step k = 2k + (a[k] < x) compiles to a conditional set instead of
+     a branch; mispredictions disappear regardless of the queries.
+   - The tree is always perfectly balanced (height ceil(log2(n+1))), even
+     if the pointer tree was built from sorted input.
+   - Menu option 8 compares lookup throughput with the pointer tree.
+
+10. Treap mode (chosen at startup):
+   - Every node gets a random priority; the tree is a BST on the keys and a
+     max-heap on the priorities. Its shape is that of a BST built from the
+     keys in random order, so the expected height is O(log n) (~3 log2 n)
+     even for sorted input, where the plain BST degenerates to a chain.
+   - split(t, x): cut t into keys before x and keys after x in one walk
+     down the tree. merge(l, r): join two treaps (all of l before all of r)
+     by repeatedly keeping the root with the higher priority.
+   - Insert: walk down until a node with lower priority, split that
+     subtree around the new key and hang the halves below the new node.
+   - Delete: replace the node by merge(left, right).
+   - Union: the root with the higher priority stays on top, the other treap
+     is split around it and both halves are united recursively —
+     expected O(m log(n/m + 1)) for sizes m <= n.
+   - Search, find minimum, longest path and mirror are unchanged.
+   - Menu option 11 inserts 1..n in order and checks the height stays
+     logarithmic.
+
+11. Batch search (searchBatch):
+   - A single search stalls on a cache miss at almost every level of a
+     large tree. searchBatch keeps 16 lookups in flight and advances them
+     one level at a time in turn, prefetching each lookup's next node, so
+     up to 16 memory accesses overlap instead of happening one after another.
+   - A finished lookup writes its result and its slot immediately starts
+     the next key of the batch.
+   - Menu option 12 compares throughput with calling search() per key.
 */
@@ -1,52 +1,294 @@
 #include <iostream>     // Includes standard input and output operations
 #include <stack>        // Includes the stack container from STL for stack-based operations
 #include <cctype>       // Includes functions like isalpha to check character types
+#include <vector>       // For the compiled bytecode and variable bindings
+#include <cstdint>      // For fixed width opcode fields
+#include <chrono>       // For measuring evaluation throughput
+#include <random>       // For random variable bindings in the benchmark
+#include <algorithm>    // For min and copy in columnar evaluation
+#include <string>       // For identifiers and error messages
+#include <sstream>      // For printing numbers
+#include <cmath>        // For pow
+#include <cstdlib>      // For strtod
+#include <cstring>      // For memcpy
+#include <unordered_map> // For hash-consing and variable slots
+#include <unordered_set> // For visiting shared nodes only once
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>  // AVX2 intrinsics for columnar evaluation
+#define HAVE_AVX2_KERNELS 1
+#endif
 using namespace std;    // To avoid prefixing std:: before standard names like cout, cin, stack
 
+// Kinds of node in the expression tree
+enum NodeKind : uint8_t { NODE_NUMBER, NODE_VARIABLE, NODE_OPERATOR };
+
 // Structure to define a node in the expression tree
 struct TreeNode {
-    char data;               // Stores the character (operand or operator)
-    TreeNode* left;          // Pointer to the left child of the node
-    TreeNode* right;         // Pointer to the right child of the node
+    NodeKind kind;           // Number, variable or operator
+    char data;               // Operator character (+ - * / ^, '~' for unary minus); 0 for operands
+    double value;            // Value of a number node
+    string name;             // Name of a variable node
+    TreeNode* left;          // Pointer to the left child (the only child of unary minus)
+    TreeNode* right;         // Pointer to the right child (nullptr for unary minus)
 
-    // Constructor to initialize node with character value
-    TreeNode(char val) {
-        data = val;
-        left = nullptr;
-        right = nullptr;
-    }
+    // Constructor for an operator node
+    TreeNode(char op, TreeNode* l, TreeNode* r)
+        : kind(NODE_OPERATOR), data(op), value(0), left(l), right(r) {}
+
+    // Constructor for a number node
+    explicit TreeNode(double v)
+        : kind(NODE_NUMBER), data(0), value(v), left(nullptr), right(nullptr) {}
+
+    // Constructor for a variable node
+    explicit TreeNode(const string& n)
+        : kind(NODE_VARIABLE), data(0), value(0), name(n), left(nullptr), right(nullptr) {}
 };
 
-// Function to check if a character is an operator
+// Notations accepted by the parser
+enum Notation { PREFIX, INFIX, POSTFIX };
+
+// Function to check if a character is a binary operator
 bool isOperator(char c) {
-    return (c == '+' || c == '-' || c == '*' || c == '/');  // Returns true if character is any arithmetic operator
+    return (c == '+' || c == '-' || c == '*' || c == '/' || c == '^');  // Returns true if character is any arithmetic operator
+}
+
+// Token produced by the tokenizer
+enum TokenType { TOK_NUMBER, TOK_IDENT, TOK_OPERATOR, TOK_LPAREN, TOK_RPAREN };
+
+struct Token {
+    TokenType type;
+    string text;             // Identifier name or operator character
+    double value;            // Value of a number token
+};
+
+// Function to split an expression into tokens: numbers (12, 3.5), identifiers
+// (x, rate_2), operators (+ - * / ^ and ~ for unary minus) and parentheses.
+// With splitLetters every letter is its own single-letter identifier, which
+// keeps the classic unspaced prefix form (+--a*bc/def) working.
+bool tokenize(const string& text, bool splitLetters, vector<Token>& tokens, string& error) {
+    tokens.clear();
+    size_t i = 0;
+    while (i < text.size()) {
+        char c = text[i];
+        if (isspace((unsigned char)c)) {
+            i++;
+        } else if (isdigit((unsigned char)c) || (c == '.' && i + 1 < text.size() && isdigit((unsigned char)text[i + 1]))) {
+            size_t j = i;
+            while (j < text.size() && isdigit((unsigned char)text[j])) j++;
+            if (j < text.size() && text[j] == '.') {
+                j++;
+                while (j < text.size() && isdigit((unsigned char)text[j])) j++;
+            }
+            tokens.push_back({TOK_NUMBER, text.substr(i, j - i), strtod(text.c_str() + i, nullptr)});
+            i = j;
+        } else if (isalpha((unsigned char)c) || c == '_') {
+            size_t j = i + 1;
+            if (!splitLetters)
+                while (j < text.size() && (isalnum((unsigned char)text[j]) || text[j] == '_')) j++;
+            tokens.push_back({TOK_IDENT, text.substr(i, j - i), 0});
+            i = j;
+        } else if (isOperator(c) || c == '~') {
+            tokens.push_back({TOK_OPERATOR, string(1, c), 0});
+            i++;
+        } else if (c == '(' || c == ')') {
+            tokens.push_back({c == '(' ? TOK_LPAREN : TOK_RPAREN, string(1, c), 0});
+            i++;
+        } else {
+            error = string("Unexpected character '") + c + "' at position " + to_string(i);
+            return false;
+        }
+    }
+    if (tokens.empty()) {
+        error = "Empty expression";
+        return false;
+    }
+    return true;
 }
 
-// Function to construct expression tree from given prefix expression
-TreeNode* constructExpressionTree(const string& prefix) {
-    stack<TreeNode*> st;                      // Create a stack to hold TreeNode pointers
+// Function to free every tree left on a parser stack after an error
+void deleteTree(TreeNode* root);
+void freeStack(stack<TreeNode*>& st) {
+    while (!st.empty()) {
+        deleteTree(st.top());
+        st.pop();
+    }
+}
 
-    // Traverse the prefix expression from right to left
-    for (int i = prefix.length() - 1; i >= 0; i--) {
-        char c = prefix[i];                  // Get current character from the expression
+// Function to build an operand node from a number or identifier token
+TreeNode* operandNode(const Token& t) {
+    return t.type == TOK_NUMBER ? new TreeNode(t.value) : new TreeNode(t.text);
+}
 
-        if (isalpha(c)) {                    // Check if current character is an operand
-            TreeNode* node = new TreeNode(c);  // Create a new node with operand
-            st.push(node);                   // Push the node to stack since operand needs no processing yet
-        } else if (isOperator(c)) {          // Check if the current character is an operator
-            TreeNode* node = new TreeNode(c);  // Create a new node for the operator
-            TreeNode* left = st.top(); st.pop();   // Pop the top node from stack as left child
-            TreeNode* right = st.top(); st.pop();  // Pop the next node from stack as right child
-            node->left = left;              // Set left child
-            node->right = right;            // Set right child
-            st.push(node);                  // Push the new subtree root back to stack
+// Function to construct the tree from prefix or postfix tokens. Prefix is
+// scanned right to left, postfix left to right; either way operands are
+// pushed and an operator pops its operands and pushes the new subtree.
+TreeNode* buildFromPolish(const vector<Token>& tokens, bool prefix, string& error) {
+    stack<TreeNode*> st;
+    for (size_t k = 0; k < tokens.size(); k++) {
+        const Token& t = tokens[prefix ? tokens.size() - 1 - k : k];
+        if (t.type == TOK_NUMBER || t.type == TOK_IDENT) {
+            st.push(operandNode(t));                  // Operand needs no processing yet
+            continue;
+        }
+        if (t.type != TOK_OPERATOR) {
+            error = "Parentheses are only allowed in infix expressions";
+            freeStack(st);
+            return nullptr;
+        }
+        char op = t.text[0];
+        size_t arity = (op == '~') ? 1 : 2;
+        if (st.size() < arity) {
+            error = string("Missing operand for '") + op + "'";
+            freeStack(st);
+            return nullptr;
+        }
+        TreeNode* first = st.top(); st.pop();
+        TreeNode* second = nullptr;
+        if (arity == 2) {
+            second = st.top(); st.pop();
         }
+        if (arity == 1) st.push(new TreeNode(op, first, nullptr));
+        else if (prefix) st.push(new TreeNode(op, first, second)); // Prefix: first popped is the left child
+        else st.push(new TreeNode(op, second, first));             // Postfix: first popped is the right child
+    }
+    if (st.size() != 1) {
+        error = "Missing operator: " + to_string(st.size()) + " operands left over";
+        freeStack(st);
+        return nullptr;
     }
     return st.top();                         // Final element in stack is the root of the complete tree
 }
 
-// Function to perform post-order traversal without recursion
-void postOrderTraversal(TreeNode* root) {
+// Precedence of an infix operator; '~' (unary minus) binds tighter than
+// * and / but looser than ^, so -x^2 is -(x^2)
+int precedence(char op) {
+    switch (op) {
+        case '+': case '-': return 1;
+        case '*': case '/': return 2;
+        case '~': return 3;
+        case '^': return 4;
+        default: return 0;
+    }
+}
+
+// Function to pop one operator and attach its operands (infix parser helper)
+bool reduceOperator(stack<TreeNode*>& operands, stack<char>& operators, string& error) {
+    char op = operators.top(); operators.pop();
+    size_t arity = (op == '~') ? 1 : 2;
+    if (operands.size() < arity) {
+        error = string("Missing operand for '") + (op == '~' ? '-' : op) + "'";
+        return false;
+    }
+    TreeNode* right = operands.top(); operands.pop();
+    if (arity == 1) {
+        operands.push(new TreeNode(op, right, nullptr));
+    } else {
+        TreeNode* left = operands.top(); operands.pop();
+        operands.push(new TreeNode(op, left, right));
+    }
+    return true;
+}
+
+// Function to construct the tree from infix tokens (shunting-yard).
+// ^ is right associative, the others left associative; a '-' or '+' where
+// an operand is expected is a unary sign.
+TreeNode* buildFromInfix(const vector<Token>& tokens, string& error) {
+    stack<TreeNode*> operands;
+    stack<char> operators;                   // Operators and '(' waiting for their operands
+    bool expectOperand = true;               // True at the start, after an operator and after '('
+    bool ok = true;
+
+    for (size_t k = 0; k < tokens.size() && ok; k++) {
+        const Token& t = tokens[k];
+        if (t.type == TOK_NUMBER || t.type == TOK_IDENT) {
+            if (!expectOperand) {
+                error = "Missing operator before '" + t.text + "'";
+                ok = false;
+                break;
+            }
+            operands.push(operandNode(t));
+            expectOperand = false;
+        } else if (t.type == TOK_LPAREN) {
+            if (!expectOperand) {
+                error = "Missing operator before '('";
+                ok = false;
+                break;
+            }
+            operators.push('(');
+        } else if (t.type == TOK_RPAREN) {
+            while (ok && !operators.empty() && operators.top() != '(')
+                ok = reduceOperator(operands, operators, error);
+            if (ok && (operators.empty() || expectOperand)) {
+                error = operators.empty() ? "Unmatched ')'" : "Empty parentheses or missing operand";
+                ok = false;
+            }
+            if (ok) operators.pop();         // Discard the '('
+        } else {
+            char op = t.text[0];
+            if (expectOperand) {             // Unary sign
+                if (op == '+') continue;     // Unary plus changes nothing
+                if (op != '-' && op != '~') {
+                    error = string("Missing operand before '") + op + "'";
+                    ok = false;
+                    break;
+                }
+                operators.push('~');         // Prefix operator: nothing to reduce yet
+                continue;
+            }
+            if (op == '~') {
+                error = "Unary minus '~' cannot follow an operand";
+                ok = false;
+                break;
+            }
+            while (ok && !operators.empty() && operators.top() != '(' &&
+                   (precedence(operators.top()) > precedence(op) ||
+                    (precedence(operators.top()) == precedence(op) && op != '^')))
+                ok = reduceOperator(operands, operators, error);
+            operators.push(op);
+            expectOperand = true;
+        }
+    }
+    if (ok && expectOperand) {
+        error = "Expression ends with an operator";
+        ok = false;
+    }
+    while (ok && !operators.empty()) {
+        if (operators.top() == '(') {
+            error = "Unmatched '('";
+            ok = false;
+        } else {
+            ok = reduceOperator(operands, operators, error);
+        }
+    }
+    if (!ok) {
+        freeStack(operands);
+        return nullptr;
+    }
+    return operands.top();
+}
+
+// Function to construct an expression tree from an expression in the given
+// notation. Returns nullptr and sets error if the expression is malformed.
+TreeNode* constructExpressionTree(const string& expression, Notation notation, string& error) {
+    // Unspaced prefix/postfix keeps the original single-letter operands
+    bool splitLetters = notation != INFIX && expression.find_first_of(" \t") == string::npos;
+    vector<Token> tokens;
+    if (!tokenize(expression, splitLetters, tokens, error)) return nullptr;
+    if (notation == INFIX) return buildFromInfix(tokens, error);
+    return buildFromPolish(tokens, notation == PREFIX, error);
+}
+
+// Function to get the printable text of a node
+string nodeText(const TreeNode* node) {
+    if (node->kind == NODE_VARIABLE) return node->name;
+    if (node->kind == NODE_OPERATOR) return string(1, node->data);
+    ostringstream out;
+    out << node->value;
+    return out.str();
+}
+
+// Function to perform post-order traversal without recursion, printing to out
+void postOrderTraversal(TreeNode* root, ostream& out = cout) {
     if (!root) return;                       // If tree is empty, no traversal needed
 
     stack<TreeNode*> s1, s2;                 // Two stacks: one for processing nodes, one for storing post-order
@@ -63,13 +305,14 @@ void postOrderTraversal(TreeNode* root) {
 
     // Now s2 contains nodes in reverse post-order, so print them
     while (!s2.empty()) {
-        cout << s2.top()->data << " ";       // Print node data in correct post-order
+        out << nodeText(s2.top()) << " ";    // Print node data in correct post-order
         s2.pop();
     }
-    cout << endl;
+    out << endl;
 }
 
-// Function to delete all nodes of the tree (post-order deletion)
+// Function to delete all nodes of the tree (post-order deletion).
+// Every node has one parent, as in any tree the parsers build.
 void deleteTree(TreeNode* root) {
     if (!root) return;                       // If root is null, nothing to delete
 
@@ -86,35 +329,1257 @@ void deleteTree(TreeNode* root) {
     }
 }
 
+// Function to delete all nodes of a DAG built by optimizeExpression, where
+// a node may be shared by several parents: nodes already deleted are
+// remembered and skipped.
+void deleteDag(TreeNode* root) {
+    if (!root) return;
+
+    stack<TreeNode*> st;
+    unordered_set<TreeNode*> seen;           // Nodes already pushed for deletion
+    st.push(root);
+    seen.insert(root);
+
+    while (!st.empty()) {
+        TreeNode* curr = st.top(); st.pop();
+
+        if (curr->left && seen.insert(curr->left).second) st.push(curr->left);
+        if (curr->right && seen.insert(curr->right).second) st.push(curr->right);
+
+        delete curr;
+    }
+}
+
+// Function to count the distinct nodes of a tree or DAG
+size_t countNodes(TreeNode* root) {
+    if (!root) return 0;
+    stack<TreeNode*> st;
+    unordered_set<TreeNode*> seen;
+    st.push(root);
+    seen.insert(root);
+    while (!st.empty()) {
+        TreeNode* curr = st.top(); st.pop();
+        if (curr->left && seen.insert(curr->left).second) st.push(curr->left);
+        if (curr->right && seen.insert(curr->right).second) st.push(curr->right);
+    }
+    return seen.size();
+}
+
+// Function to count the distinct variable names used by a tree
+size_t countVariables(TreeNode* root) {
+    if (!root) return 0;
+    stack<TreeNode*> st;
+    unordered_set<string> names;
+    st.push(root);
+    while (!st.empty()) {
+        TreeNode* curr = st.top(); st.pop();
+        if (curr->kind == NODE_VARIABLE) names.insert(curr->name);
+        if (curr->left) st.push(curr->left);
+        if (curr->right) st.push(curr->right);
+    }
+    return names.size();
+}
+
+// ---------------------------------------------------------------------------
+// Optimization: constant folding, algebraic simplification and common
+// subexpression elimination. The result is a DAG in which every distinct
+// subexpression exists exactly once.
+// ---------------------------------------------------------------------------
+
+// Identity of a node for hash-consing: two nodes with the same key compute
+// the same value, so one of them is enough
+struct NodeKey {
+    NodeKind kind;
+    char op;
+    uint64_t valueBits;      // Bit pattern of the number (keeps 0 and -0 apart)
+    string name;
+    TreeNode* left;
+    TreeNode* right;
+
+    bool operator==(const NodeKey& o) const {
+        return kind == o.kind && op == o.op && valueBits == o.valueBits && name == o.name &&
+               left == o.left && right == o.right;
+    }
+};
+
+struct NodeKeyHash {
+    size_t operator()(const NodeKey& k) const {
+        size_t h = hash<string>()(k.name);
+        h = h * 31 + k.kind;
+        h = h * 31 + (unsigned char)k.op;
+        h = h * 31 + hash<uint64_t>()(k.valueBits);
+        h = h * 31 + hash<TreeNode*>()(k.left);
+        h = h * 31 + hash<TreeNode*>()(k.right);
+        return h;
+    }
+};
+
+typedef unordered_map<NodeKey, TreeNode*, NodeKeyHash> NodeTable;
+
+// Function to return the unique node with this identity, creating it if needed
+TreeNode* internNode(NodeTable& table, NodeKind kind, char op, double value, const string& name,
+                     TreeNode* left, TreeNode* right) {
+    NodeKey key;
+    key.kind = kind;
+    key.op = op;
+    memcpy(&key.valueBits, &value, sizeof(value));
+    key.name = name;
+    key.left = left;
+    key.right = right;
+    auto it = table.find(key);
+    if (it != table.end()) return it->second;  // Common subexpression: reuse it
+
+    TreeNode* node;
+    if (kind == NODE_NUMBER) node = new TreeNode(value);
+    else if (kind == NODE_VARIABLE) node = new TreeNode(name);
+    else node = new TreeNode(op, left, right);
+    table.emplace(key, node);
+    return node;
+}
+
+// Function to apply an operator to two numbers (used for constant folding)
+double applyOperator(char op, double a, double b) {
+    switch (op) {
+        case '+': return a + b;
+        case '-': return a - b;
+        case '*': return a * b;
+        case '/': return a / b;
+        case '^': return pow(a, b);
+        case '~': return -a;
+        default: return 0;
+    }
+}
+
+bool isNumber(const TreeNode* node, double v) {
+    return node->kind == NODE_NUMBER && node->value == v;
+}
+
+// Function to simplify one operator node whose children are already
+// optimized; returns the (interned) replacement node
+TreeNode* simplifyNode(NodeTable& table, char op, TreeNode* l, TreeNode* r) {
+    // Constant folding: every operand is a number
+    if (l->kind == NODE_NUMBER && (!r || r->kind == NODE_NUMBER))
+        return internNode(table, NODE_NUMBER, 0, applyOperator(op, l->value, r ? r->value : 0), "", nullptr, nullptr);
+
+    switch (op) {
+        case '~':
+            if (l->kind == NODE_OPERATOR && l->data == '~') return l->left;   // -(-x) = x
+            break;
+        case '+':
+            if (isNumber(l, 0)) return r;                                     // 0 + x = x
+            if (isNumber(r, 0)) return l;                                     // x + 0 = x
+            break;
+        case '-':
+            if (isNumber(r, 0)) return l;                                     // x - 0 = x
+            if (isNumber(l, 0)) return simplifyNode(table, '~', r, nullptr);  // 0 - x = -x
+            break;
+        case '*':
+            if (isNumber(l, 1)) return r;                                     // 1 * x = x
+            if (isNumber(r, 1)) return l;                                     // x * 1 = x
+            break;
+        case '/':
+            if (isNumber(r, 1)) return l;                                     // x / 1 = x
+            break;
+        case '^':
+            if (isNumber(r, 1)) return l;                                     // x ^ 1 = x
+            if (isNumber(r, 0) || isNumber(l, 1))                             // x ^ 0 = 1 ^ x = 1
+                return internNode(table, NODE_NUMBER, 0, 1.0, "", nullptr, nullptr);
+            break;
+    }
+    return internNode(table, NODE_OPERATOR, op, 0, "", l, r);
+}
+
+// Function to build the optimized DAG for a tree. The original tree is left
+// untouched; the caller deletes it once the new root is in place.
+TreeNode* optimizeExpression(TreeNode* root) {
+    if (!root) return nullptr;
+    NodeTable table;
+    unordered_map<TreeNode*, TreeNode*> result;       // Original node -> optimized node
+    stack<pair<TreeNode*, bool>> work;                // (node, children already done)
+    work.push(make_pair(root, false));
+
+    while (!work.empty()) {
+        TreeNode* node = work.top().first;
+        bool childrenDone = work.top().second;
+        work.pop();
+        if (result.count(node)) continue;             // Shared node already optimized
+        if (!childrenDone) {
+            work.push(make_pair(node, true));         // Revisit after the children
+            if (node->right) work.push(make_pair(node->right, false));
+            if (node->left) work.push(make_pair(node->left, false));
+            continue;
+        }
+        if (node->kind == NODE_NUMBER)
+            result[node] = internNode(table, NODE_NUMBER, 0, node->value, "", nullptr, nullptr);
+        else if (node->kind == NODE_VARIABLE)
+            result[node] = internNode(table, NODE_VARIABLE, 0, 0, node->name, nullptr, nullptr);
+        else
+            result[node] = simplifyNode(table, node->data, result[node->left],
+                                        node->right ? result[node->right] : nullptr);
+    }
+
+    // Interned nodes that ended up unused (e.g. the 0 in x + 0) are freed
+    TreeNode* newRoot = result[root];
+    unordered_set<TreeNode*> reachable;
+    stack<TreeNode*> st;
+    st.push(newRoot);
+    reachable.insert(newRoot);
+    while (!st.empty()) {
+        TreeNode* curr = st.top(); st.pop();
+        if (curr->left && reachable.insert(curr->left).second) st.push(curr->left);
+        if (curr->right && reachable.insert(curr->right).second) st.push(curr->right);
+    }
+    for (auto& entry : table)
+        if (!reachable.count(entry.second)) delete entry.second;
+    return newRoot;
+}
+
+// Opcodes of the stack machine that runs compiled expressions
+enum OpCode : uint8_t { OP_LOAD, OP_CONST, OP_ADD, OP_SUB, OP_MUL, OP_DIV, OP_POW, OP_NEG, OP_SAVE, OP_TEMP };
+
+// One bytecode instruction: an opcode plus its operand index
+struct Instruction {
+    OpCode op;               // What to do
+    uint32_t arg;            // Variable slot (OP_LOAD), constant (OP_CONST) or temporary (OP_SAVE/OP_TEMP)
+};
+
+const int MAX_VARIABLES = 26;  // Distinct variables one expression may use
+
+// Values of the variables for one evaluation
+struct Binding {
+    double value[MAX_VARIABLES]; // value[slot] is the value of Program::vars[slot]
+};
+
+// Flat postfix program compiled from an expression tree
+struct Program {
+    vector<Instruction> code; // Instructions in postfix (evaluation) order
+    vector<string> vars;      // Variable name of each slot, in order of first use
+    vector<double> constants; // Values used by OP_CONST
+    int maxStack = 0;         // Deepest operand stack the program needs
+    int temps = 0;            // Temporaries holding shared subexpressions
+
+    // Doubles the evaluation frame needs: the operand stack, then the temporaries
+    int frameSize() const { return maxStack + temps; }
+};
+
+// Function to compile the expression tree into postfix bytecode.
+// Post-order walk with an explicit stack; a subexpression shared by several
+// parents (after CSE) is computed once, saved in a temporary (OP_SAVE) and
+// reloaded (OP_TEMP) wherever it is used again.
+Program compileExpression(TreeNode* root) {
+    Program prog;
+    if (!root) return prog;
+
+    // Count the parents of every node to find the shared ones
+    unordered_map<TreeNode*, int> parents;
+    stack<TreeNode*> st;
+    st.push(root);
+    parents[root] = 1;
+    while (!st.empty()) {
+        TreeNode* curr = st.top(); st.pop();
+        for (TreeNode* child : {curr->left, curr->right}) {
+            if (child && parents[child]++ == 0) st.push(child);
+        }
+    }
+
+    unordered_map<TreeNode*, int> tempOf;    // Shared node -> its temporary
+    unordered_map<string, int> slotOf;       // Variable name -> slot
+    unordered_map<uint64_t, int> constantOf; // Bit pattern of a number -> its constant
+    int depth = 0;                           // Operand stack depth while emitting
+    stack<pair<TreeNode*, bool>> work;       // (node, children already emitted)
+    work.push(make_pair(root, false));
+
+    while (!work.empty()) {
+        TreeNode* node = work.top().first;
+        bool childrenDone = work.top().second;
+        work.pop();
+
+        Instruction ins;
+        ins.op = OP_NEG;
+        ins.arg = 0;
+        if (!childrenDone) {
+            auto t = tempOf.find(node);
+            if (t != tempOf.end()) {         // Already computed: reload it
+                ins.op = OP_TEMP;
+                ins.arg = t->second;
+                prog.code.push_back(ins);
+                if (++depth > prog.maxStack) prog.maxStack = depth;
+                continue;
+            }
+            if (node->kind == NODE_OPERATOR) {
+                work.push(make_pair(node, true));   // Emit the operator after its operands
+                if (node->right) work.push(make_pair(node->right, false));
+                work.push(make_pair(node->left, false));
+                continue;
+            }
+        }
+
+        switch (node->kind) {
+            case NODE_NUMBER: {                  // Operand: equal numbers share one constant
+                uint64_t bits;
+                memcpy(&bits, &node->value, sizeof(bits));
+                auto constant = constantOf.find(bits);
+                ins.op = OP_CONST;
+                if (constant != constantOf.end()) {
+                    ins.arg = constant->second;
+                } else {
+                    ins.arg = prog.constants.size();
+                    constantOf[bits] = ins.arg;
+                    prog.constants.push_back(node->value);
+                }
+                break;
+            }
+            case NODE_VARIABLE: {                // Operand: load the variable
+                auto slot = slotOf.find(node->name);
+                ins.op = OP_LOAD;
+                if (slot != slotOf.end()) {
+                    ins.arg = slot->second;
+                } else {
+                    ins.arg = prog.vars.size();
+                    slotOf[node->name] = ins.arg;
+                    prog.vars.push_back(node->name);
+                }
+                break;
+            }
+            case NODE_OPERATOR:
+                switch (node->data) {
+                    case '+': ins.op = OP_ADD; break;
+                    case '-': ins.op = OP_SUB; break;
+                    case '*': ins.op = OP_MUL; break;
+                    case '/': ins.op = OP_DIV; break;
+                    case '^': ins.op = OP_POW; break;
+                    default:  break;                    // '~' stays OP_NEG
+                }
+                break;
+        }
+        // Loads push one value, unary minus keeps the depth, binary operators pop two push one
+        if (ins.op == OP_LOAD || ins.op == OP_CONST) depth++;
+        else if (ins.op != OP_NEG) depth--;
+        if (depth > prog.maxStack) prog.maxStack = depth;
+        prog.code.push_back(ins);
+
+        if (parents[node] > 1) {             // Keep a copy for the other parents
+            Instruction save;
+            save.op = OP_SAVE;
+            save.arg = prog.temps++;
+            tempOf[node] = save.arg;
+            prog.code.push_back(save);
+        }
+    }
+    return prog;
+}
+
+// Function to run a compiled program on a caller-provided frame of
+// prog.frameSize() doubles; vars[slot] holds the value of prog.vars[slot]
+double runProgram(const Program& prog, const double* vars, double* st) {
+    double* temp = st + prog.maxStack;       // Temporaries live after the operand stack
+    int top = -1;                            // Index of the top of the operand stack
+    for (const Instruction& ins : prog.code) {
+        switch (ins.op) {
+            case OP_LOAD:  st[++top] = vars[ins.arg]; break;
+            case OP_CONST: st[++top] = prog.constants[ins.arg]; break;
+            case OP_ADD:   st[top - 1] += st[top]; top--; break; // left + right
+            case OP_SUB:   st[top - 1] -= st[top]; top--; break; // left - right
+            case OP_MUL:   st[top - 1] *= st[top]; top--; break; // left * right
+            case OP_DIV:   st[top - 1] /= st[top]; top--; break; // left / right
+            case OP_POW:   st[top - 1] = pow(st[top - 1], st[top]); top--; break;
+            case OP_NEG:   st[top] = -st[top]; break;
+            case OP_SAVE:  temp[ins.arg] = st[top]; break;       // Value stays on the stack
+            case OP_TEMP:  st[++top] = temp[ins.arg]; break;
+        }
+    }
+    return st[0];
+}
+
+// Function to evaluate a compiled program for one binding
+double evaluate(const Program& prog, const Binding& vars) {
+    vector<double> st(prog.frameSize());
+    return runProgram(prog, vars.value, st.data());
+}
+
+// Function to evaluate a compiled program over many bindings; the tree is
+// not touched and the operand stack is allocated once for the whole batch
+void evaluateBatch(const Program& prog, const vector<Binding>& bindings, vector<double>& results) {
+    vector<double> st(prog.frameSize());
+    results.resize(bindings.size());
+    for (size_t i = 0; i < bindings.size(); i++) {
+        results[i] = runProgram(prog, bindings[i].value, st.data());
+    }
+}
+
+// Benchmark: evaluate the compiled program over n random bindings
+void benchmarkEvaluation(TreeNode* root, int n) {
+    Program prog = compileExpression(root);
+    vector<Binding> bindings(n);
+    mt19937 rng(17);
+    uniform_real_distribution<double> dist(1.0, 10.0); // Keep divisors away from zero
+    for (Binding& b : bindings)
+        for (double& v : b.value) v = dist(rng);
+
+    vector<double> results;
+    auto start = chrono::steady_clock::now();
+    evaluateBatch(prog, bindings, results);
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    double checksum = 0;                     // Use the results so they are not optimised away
+    for (double r : results) checksum += r;
+    cout << "Instructions: " << prog.code.size() << ", evaluations: " << n << ", time: "
+         << seconds * 1000 << " ms, throughput: " << n / seconds / 1e6 << " M evaluations/sec"
+         << " (checksum " << checksum << ")\n";
+}
+
+// ---------------------------------------------------------------------------
+// Columnar evaluation: instead of running the program once per row, each
+// instruction is applied to a whole block of rows at once. Every variable is
+// a column (array with one value per row); operators combine two columns
+// element by element, which maps directly onto SIMD instructions.
+// ---------------------------------------------------------------------------
+
+const size_t COLUMN_BLOCK = 1024;           // Rows per block (8 KB per buffer, stays in L1/L2)
+
+// Portable kernel: d[i] = a[i] op b[i] for n rows
+void applyScalar(OpCode op, double* d, const double* a, const double* b, size_t n) {
+    switch (op) {
+        case OP_ADD: for (size_t i = 0; i < n; i++) d[i] = a[i] + b[i]; break;
+        case OP_SUB: for (size_t i = 0; i < n; i++) d[i] = a[i] - b[i]; break;
+        case OP_MUL: for (size_t i = 0; i < n; i++) d[i] = a[i] * b[i]; break;
+        case OP_DIV: for (size_t i = 0; i < n; i++) d[i] = a[i] / b[i]; break;
+        case OP_POW: for (size_t i = 0; i < n; i++) d[i] = pow(a[i], b[i]); break;
+        default: break;
+    }
+}
+
+#ifdef HAVE_AVX2_KERNELS
+// AVX2 kernel: four doubles per instruction, scalar loop for the tail
+#define AVX2_LOOP(INTRINSIC, OPERATOR)                                             \
+    for (; i + 4 <= n; i += 4)                                                     \
+        _mm256_storeu_pd(d + i, INTRINSIC(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i))); \
+    for (; i < n; i++) d[i] = a[i] OPERATOR b[i];
+
+__attribute__((target("avx2")))
+void applyAvx2(OpCode op, double* d, const double* a, const double* b, size_t n) {
+    size_t i = 0;
+    switch (op) {
+        case OP_ADD: AVX2_LOOP(_mm256_add_pd, +); break;
+        case OP_SUB: AVX2_LOOP(_mm256_sub_pd, -); break;
+        case OP_MUL: AVX2_LOOP(_mm256_mul_pd, *); break;
+        case OP_DIV: AVX2_LOOP(_mm256_div_pd, /); break;
+        default: applyScalar(op, d, a, b, n); break;  // No vector pow: scalar loop
+    }
+}
+#undef AVX2_LOOP
+#endif
+
+// True if this CPU can run the AVX2 kernels
+bool cpuHasAvx2() {
+#ifdef HAVE_AVX2_KERNELS
+    return __builtin_cpu_supports("avx2");
+#else
+    return false;
+#endif
+}
+
+// Function to evaluate a compiled program over `rows` rows given as columns:
+// columns[slot] points to the values of variable prog.vars[slot]. Results
+// are written to out.
+void evaluateColumns(const Program& prog, const double* const columns[], size_t rows,
+                     double* out, bool allowSimd = true) {
+    bool avx2 = allowSimd && cpuHasAvx2();
+    // One scratch buffer per stack level; a stack entry is either a slice of
+    // an input column (no copy), a constant block or a scratch buffer
+    vector<double> scratch(max(prog.maxStack, 1) * COLUMN_BLOCK);
+    vector<double> temps(prog.temps * COLUMN_BLOCK);                 // Saved shared subexpressions
+    vector<double> constants(prog.constants.size() * COLUMN_BLOCK);  // Each constant broadcast once
+    for (size_t c = 0; c < prog.constants.size(); c++)
+        fill(constants.begin() + c * COLUMN_BLOCK, constants.begin() + (c + 1) * COLUMN_BLOCK, prog.constants[c]);
+    vector<const double*> st(max(prog.maxStack, 1));
+
+    for (size_t begin = 0; begin < rows; begin += COLUMN_BLOCK) {
+        size_t n = min(COLUMN_BLOCK, rows - begin);
+        int top = -1;
+        for (const Instruction& ins : prog.code) {
+            switch (ins.op) {
+                case OP_LOAD:  st[++top] = columns[ins.arg] + begin; continue;
+                case OP_CONST: st[++top] = &constants[ins.arg * COLUMN_BLOCK]; continue;
+                case OP_TEMP:  st[++top] = &temps[ins.arg * COLUMN_BLOCK]; continue;
+                case OP_SAVE:  copy(st[top], st[top] + n, &temps[ins.arg * COLUMN_BLOCK]); continue;
+                case OP_NEG: {
+                    double* dst = &scratch[top * COLUMN_BLOCK];
+                    const double* src = st[top];
+                    for (size_t i = 0; i < n; i++) dst[i] = -src[i];
+                    st[top] = dst;
+                    continue;
+                }
+                default: break;
+            }
+            double* dst = &scratch[(top - 1) * COLUMN_BLOCK]; // Result replaces the left operand
+#ifdef HAVE_AVX2_KERNELS
+            if (avx2) applyAvx2(ins.op, dst, st[top - 1], st[top], n);
+            else
+#endif
+            applyScalar(ins.op, dst, st[top - 1], st[top], n);
+            st[--top] = dst;
+        }
+        copy(st[0], st[0] + n, out + begin);
+    }
+}
+
+// Benchmark: row-at-a-time bytecode vs. columnar scalar vs. columnar AVX2
+void benchmarkColumns(TreeNode* root, size_t rows) {
+    Program prog = compileExpression(root);
+    int usedCount = prog.vars.size();
+
+    mt19937 rng(19);
+    uniform_real_distribution<double> dist(1.0, 10.0);
+    vector<vector<double>> data(usedCount);
+    vector<const double*> columns(usedCount);
+    for (int v = 0; v < usedCount; v++) {       // Only the columns the expression reads
+        data[v].resize(rows);
+        for (double& x : data[v]) x = dist(rng);
+        columns[v] = data[v].data();
+    }
+    vector<double> out(rows), check(rows);
+
+    auto seconds = [](chrono::steady_clock::time_point t) {
+        return chrono::duration<double>(chrono::steady_clock::now() - t).count();
+    };
+    double bytes = (double)rows * (usedCount + 1) * sizeof(double); // Columns read + result written
+
+    // Row at a time: gather the row into a binding, run the bytecode
+    auto start = chrono::steady_clock::now();
+    {
+        vector<double> st(prog.frameSize());
+        Binding b = {};
+        for (size_t r = 0; r < rows; r++) {
+            for (int v = 0; v < usedCount; v++) b.value[v] = columns[v][r];
+            check[r] = runProgram(prog, b.value, st.data());
+        }
+    }
+    double rowTime = seconds(start);
+    cout << "Rows: " << rows << ", columns: " << usedCount << "\n";
+    cout << "  Row-at-a-time bytecode: " << rows / rowTime / 1e6 << " M rows/s, "
+         << bytes / rowTime / 1e9 << " GB/s\n";
+
+    for (int simd = 0; simd < 2; simd++) {
+        if (simd && !cpuHasAvx2()) {
+            cout << "  Columnar AVX2         : not supported on this CPU\n";
+            break;
+        }
+        start = chrono::steady_clock::now();
+        evaluateColumns(prog, columns.data(), rows, out.data(), simd == 1);
+        double t = seconds(start);
+        bool same = true;
+        for (size_t r = 0; r < rows && same; r++) same = (out[r] == check[r]);
+        cout << (simd ? "  Columnar AVX2         : " : "  Columnar scalar       : ") << rows / t / 1e6
+             << " M rows/s, " << bytes / t / 1e9 << " GB/s" << (same ? "" : " (RESULTS DIFFER)") << "\n";
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Arena-allocated expression trees: nodes live in one contiguous buffer and
+// refer to their children by 32-bit index instead of pointer. Building a tree
+// appends to the buffer; destroying every tree is a single reset.
+// ---------------------------------------------------------------------------
+
+const uint32_t NO_NODE = 0xFFFFFFFFu;   // "No child" / parse failure
+const size_t MAX_NAME_LENGTH = 0xFFFF;  // Longest variable name FlatNode::length can hold
+
+// Flat node: 16 bytes, no pointers and no owned strings
+struct FlatNode {
+    NodeKind kind;           // Number, variable or operator
+    char op;                 // Operator character ('~' for unary minus)
+    uint16_t length;         // Length of a variable name
+    uint32_t left;           // Index of the left child or NO_NODE
+    uint32_t right;          // Index of the right child or NO_NODE
+    uint32_t payload;        // Number: index into numbers; variable: offset into names
+};
+
+struct ExpressionArena {
+    vector<FlatNode> nodes;  // All nodes of all trees built since the last reset
+    vector<char> names;      // Variable names, back to back
+    vector<double> numbers;  // Number values
+    vector<Token> tokens;    // Scratch buffers reused by every parse,
+    vector<uint32_t> work;   // so a warmed-up arena parses without allocating
+    vector<char> operators;
+
+    // Forget every tree at once; the buffers keep their capacity
+    void reset() {
+        nodes.clear();
+        names.clear();
+        numbers.clear();
+    }
+
+    uint32_t addOperand(const Token& t) {
+        FlatNode n;
+        n.op = 0;
+        n.left = n.right = NO_NODE;
+        if (t.type == TOK_NUMBER) {
+            n.kind = NODE_NUMBER;
+            n.length = 0;
+            n.payload = numbers.size();
+            numbers.push_back(t.value);
+        } else {
+            n.kind = NODE_VARIABLE;
+            n.length = t.text.size();
+            n.payload = names.size();
+            names.insert(names.end(), t.text.begin(), t.text.end());
+        }
+        nodes.push_back(n);
+        return nodes.size() - 1;
+    }
+
+    uint32_t addOperator(char op, uint32_t left, uint32_t right) {
+        FlatNode n;
+        n.kind = NODE_OPERATOR;
+        n.op = op;
+        n.length = 0;
+        n.left = left;
+        n.right = right;
+        n.payload = 0;
+        nodes.push_back(n);
+        return nodes.size() - 1;
+    }
+
+    // Pop one infix operator and attach its operands (see reduceOperator)
+    bool reduce(string& error) {
+        char op = operators.back(); operators.pop_back();
+        size_t arity = (op == '~') ? 1 : 2;
+        if (work.size() < arity) {
+            error = string("Missing operand for '") + (op == '~' ? '-' : op) + "'";
+            return false;
+        }
+        uint32_t right = work.back(); work.pop_back();
+        if (arity == 1) {
+            work.push_back(addOperator(op, right, NO_NODE));
+        } else {
+            uint32_t left = work.back(); work.pop_back();
+            work.push_back(addOperator(op, left, right));
+        }
+        return true;
+    }
+
+    // Same grammar and errors as constructExpressionTree; returns the index
+    // of the root, or NO_NODE (and drops the partial tree) on error
+    uint32_t parse(const string& expression, Notation notation, string& error) {
+        bool splitLetters = notation != INFIX && expression.find_first_of(" \t") == string::npos;
+        if (!tokenize(expression, splitLetters, tokens, error)) return NO_NODE;
+        for (const Token& t : tokens) {
+            if (t.type == TOK_IDENT && t.text.size() > MAX_NAME_LENGTH) {
+                error = "Variable name longer than " + to_string(MAX_NAME_LENGTH) + " characters";
+                return NO_NODE;
+            }
+        }
+        size_t nodeMark = nodes.size(), nameMark = names.size(), numberMark = numbers.size();
+        uint32_t root = (notation == INFIX) ? parseInfix(error) : parsePolish(notation == PREFIX, error);
+        if (root == NO_NODE) {               // Roll back: the partial tree is simply cut off
+            nodes.resize(nodeMark);
+            names.resize(nameMark);
+            numbers.resize(numberMark);
+        }
+        return root;
+    }
+
+    uint32_t parsePolish(bool prefix, string& error) {
+        work.clear();
+        for (size_t k = 0; k < tokens.size(); k++) {
+            const Token& t = tokens[prefix ? tokens.size() - 1 - k : k];
+            if (t.type == TOK_NUMBER || t.type == TOK_IDENT) {
+                work.push_back(addOperand(t));
+                continue;
+            }
+            if (t.type != TOK_OPERATOR) {
+                error = "Parentheses are only allowed in infix expressions";
+                return NO_NODE;
+            }
+            char op = t.text[0];
+            size_t arity = (op == '~') ? 1 : 2;
+            if (work.size() < arity) {
+                error = string("Missing operand for '") + op + "'";
+                return NO_NODE;
+            }
+            uint32_t first = work.back(); work.pop_back();
+            if (arity == 1) {
+                work.push_back(addOperator(op, first, NO_NODE));
+                continue;
+            }
+            uint32_t second = work.back(); work.pop_back();
+            work.push_back(prefix ? addOperator(op, first, second) : addOperator(op, second, first));
+        }
+        if (work.size() != 1) {
+            error = "Missing operator: " + to_string(work.size()) + " operands left over";
+            return NO_NODE;
+        }
+        return work.back();
+    }
+
+    uint32_t parseInfix(string& error) {
+        work.clear();
+        operators.clear();
+        bool expectOperand = true;
+        for (const Token& t : tokens) {
+            if (t.type == TOK_NUMBER || t.type == TOK_IDENT) {
+                if (!expectOperand) {
+                    error = "Missing operator before '" + t.text + "'";
+                    return NO_NODE;
+                }
+                work.push_back(addOperand(t));
+                expectOperand = false;
+            } else if (t.type == TOK_LPAREN) {
+                if (!expectOperand) {
+                    error = "Missing operator before '('";
+                    return NO_NODE;
+                }
+                operators.push_back('(');
+            } else if (t.type == TOK_RPAREN) {
+                while (!operators.empty() && operators.back() != '(')
+                    if (!reduce(error)) return NO_NODE;
+                if (operators.empty() || expectOperand) {
+                    error = operators.empty() ? "Unmatched ')'" : "Empty parentheses or missing operand";
+                    return NO_NODE;
+                }
+                operators.pop_back();
+            } else {
+                char op = t.text[0];
+                if (expectOperand) {
+                    if (op == '+') continue;
+                    if (op != '-' && op != '~') {
+                        error = string("Missing operand before '") + op + "'";
+                        return NO_NODE;
+                    }
+                    operators.push_back('~');
+                    continue;
+                }
+                if (op == '~') {
+                    error = "Unary minus '~' cannot follow an operand";
+                    return NO_NODE;
+                }
+                while (!operators.empty() && operators.back() != '(' &&
+                       (precedence(operators.back()) > precedence(op) ||
+                        (precedence(operators.back()) == precedence(op) && op != '^')))
+                    if (!reduce(error)) return NO_NODE;
+                operators.push_back(op);
+                expectOperand = true;
+            }
+        }
+        if (expectOperand) {
+            error = "Expression ends with an operator";
+            return NO_NODE;
+        }
+        while (!operators.empty()) {
+            if (operators.back() == '(') {
+                error = "Unmatched '('";
+                return NO_NODE;
+            }
+            if (!reduce(error)) return NO_NODE;
+        }
+        return work.back();
+    }
+
+    // Postorder text of a tree (same output as postOrderTraversal)
+    string postorder(uint32_t root) const {
+        string out;
+        vector<uint32_t> s1(1, root), s2;
+        while (!s1.empty()) {
+            uint32_t curr = s1.back(); s1.pop_back();
+            s2.push_back(curr);
+            if (nodes[curr].left != NO_NODE) s1.push_back(nodes[curr].left);
+            if (nodes[curr].right != NO_NODE) s1.push_back(nodes[curr].right);
+        }
+        for (size_t i = s2.size(); i-- > 0;) {
+            const FlatNode& n = nodes[s2[i]];
+            if (n.kind == NODE_VARIABLE) {
+                out.append(&names[n.payload], n.length);
+            } else if (n.kind == NODE_OPERATOR) {
+                out += n.op;
+            } else {
+                ostringstream num;
+                num << numbers[n.payload];
+                out += num.str();
+            }
+            out += ' ';
+        }
+        return out;
+    }
+};
+
+// Function to capture postOrderTraversal output as a string
+string postorderText(TreeNode* root) {
+    ostringstream out;
+    postOrderTraversal(root, out);
+    string text = out.str();
+    if (!text.empty() && text.back() == '\n') text.pop_back();
+    return text;
+}
+
+// Function to generate `count` random expressions with `operators` operators
+// each, written in the given notation with space-separated tokens. They are
+// generated in prefix and converted with a stack of strings.
+vector<string> randomExpressions(int count, int operators, Notation notation) {
+    static const char* const NAMES[] = {"x", "y", "rate", "price", "qty", "tax_2", "alpha", "t0"};
+    static const char OPS[] = {'+', '-', '*', '/', '^'};
+    mt19937 rng(23);
+    vector<string> result;
+    result.reserve(count);
+    vector<string> tokens;
+    vector<string> st;
+    for (int e = 0; e < count; e++) {
+        // Prefix token sequence: place operators while enough operands remain;
+        // the last pending operand must be an operator while any are left
+        tokens.clear();
+        int opsLeft = operators, pending = 1;     // Operands still required
+        while (pending > 0) {
+            bool placeOp = opsLeft > 0 && (pending == 1 || (int)(rng() % (pending + 1)) < opsLeft);
+            if (placeOp) {
+                opsLeft--;
+                if (rng() % 8 == 0) {
+                    tokens.push_back("~");        // Unary minus: still needs one operand
+                } else {
+                    tokens.push_back(string(1, OPS[rng() % 5]));
+                    pending++;
+                }
+            } else {
+                pending--;
+                if (rng() % 3 == 0) tokens.push_back(to_string(rng() % 1000));
+                else tokens.push_back(NAMES[rng() % 8]);
+            }
+        }
+        if (notation == PREFIX) {
+            string text;
+            for (const string& t : tokens) text += (text.empty() ? "" : " ") + t;
+            result.push_back(text);
+            continue;
+        }
+        st.clear();
+        for (size_t k = tokens.size(); k-- > 0;) {
+            const string& t = tokens[k];
+            if (t == "~") {
+                string a = st.back(); st.pop_back();
+                st.push_back(notation == INFIX ? "(-" + a + ")" : a + " ~");
+            } else if (t.size() == 1 && isOperator(t[0])) {
+                string a = st.back(); st.pop_back();
+                string b = st.back(); st.pop_back();
+                st.push_back(notation == INFIX ? "(" + a + " " + t + " " + b + ")" : a + " " + b + " " + t);
+            } else {
+                st.push_back(t);
+            }
+        }
+        result.push_back(st.back());
+    }
+    return result;
+}
+
+// Benchmark: parse and destroy expressions with new/delete nodes versus
+// the arena (reset before each parse, so one small buffer is reused)
+void benchmarkParsing(int count, Notation notation) {
+    const int OPERATORS = 12;
+    vector<string> exprs = randomExpressions(count, OPERATORS, notation);
+    size_t bytes = 0;
+    for (const string& e : exprs) bytes += e.size();
+    auto seconds = [](chrono::steady_clock::time_point t) {
+        return chrono::duration<double>(chrono::steady_clock::now() - t).count();
+    };
+
+    string error;
+    size_t nodes = 0;                          // Keeps the work observable
+    auto start = chrono::steady_clock::now();
+    for (const string& e : exprs) {
+        TreeNode* root = constructExpressionTree(e, notation, error);
+        nodes += root != nullptr;
+        deleteTree(root);
+    }
+    double pointerTime = seconds(start);
+
+    ExpressionArena arena;
+    start = chrono::steady_clock::now();
+    for (const string& e : exprs) {
+        arena.reset();                         // O(1) bulk delete of the previous tree
+        nodes += arena.parse(e, notation, error) != NO_NODE;
+    }
+    double arenaTime = seconds(start);
+
+    // Both parsers must build the same tree
+    TreeNode* check = constructExpressionTree(exprs[0], notation, error);
+    arena.reset();
+    bool same = postorderText(check) == arena.postorder(arena.parse(exprs[0], notation, error));
+    deleteTree(check);
+
+    cout << "Expressions: " << count << " (" << OPERATORS << " operators each), example: " << exprs[0] << "\n";
+    cout << "  new/delete nodes (" << sizeof(TreeNode) << " B/node): " << count / pointerTime / 1e3
+         << " K expr/s, " << bytes / pointerTime / 1e6 << " MB/s\n";
+    cout << "  Arena nodes      (" << sizeof(FlatNode) << " B/node): " << count / arenaTime / 1e3
+         << " K expr/s, " << bytes / arenaTime / 1e6 << " MB/s"
+         << (same ? "" : " (TREES DIFFER)") << " [" << nodes << " parsed]\n";
+}
+
+// ---------------------------------------------------------------------------
+// JIT compilation: the tree is translated into x86-64 machine code (SSE2
+// scalar double instructions) in an executable buffer and called as a plain
+// function double f(const double* vars). Where that is not possible (other
+// CPUs/OSes, an operator the code generator does not handle, or a tree too
+// deep for its recursion) evaluation falls back to the bytecode VM.
+// ---------------------------------------------------------------------------
+
+// Function to evaluate the tree directly; vars[slot] holds the value of the
+// variable whose name maps to slot
+double evaluateTree(const TreeNode* node, const double* vars, const unordered_map<string, int>& slotOf) {
+    switch (node->kind) {
+        case NODE_NUMBER: return node->value;
+        case NODE_VARIABLE: return vars[slotOf.at(node->name)];
+        default: break;
+    }
+    double l = evaluateTree(node->left, vars, slotOf);
+    if (node->data == '~') return -l;
+    return applyOperator(node->data, l, evaluateTree(node->right, vars, slotOf));
+}
+
+// Function to find the number of levels of a tree (or DAG after CSE)
+// without recursion; each shared node is measured once
+int treeDepth(const TreeNode* root) {
+    unordered_map<const TreeNode*, int> depthOf;
+    stack<pair<const TreeNode*, bool>> work;     // (node, children already measured)
+    work.push(make_pair(root, false));
+    while (!work.empty()) {
+        const TreeNode* node = work.top().first;
+        bool childrenDone = work.top().second;
+        work.pop();
+        if (depthOf.count(node)) continue;
+        if (!childrenDone) {
+            work.push(make_pair(node, true));
+            for (const TreeNode* child : {node->left, node->right})
+                if (child && !depthOf.count(child)) work.push(make_pair(child, false));
+            continue;
+        }
+        int deepest = 0;
+        for (const TreeNode* child : {node->left, node->right})
+            if (child) deepest = max(deepest, depthOf[child]);
+        depthOf[node] = deepest + 1;
+    }
+    return depthOf[root];
+}
+
+// Deepest tree the recursive code generator and tree walker are given
+const int MAX_JIT_DEPTH = 10000;
+
+typedef double (*NativeExpression)(const double* vars);
+
+// A compiled expression plus everything needed to call it
+struct JitFunction {
+    NativeExpression fn = nullptr;           // nullptr: use the bytecode fallback
+    void* memory = nullptr;                  // Executable mapping holding the code
+    size_t size = 0;
+    Program prog;                            // Bytecode for the fallback
+    mutable vector<double> frame;            // Its operand stack and temporaries
+    vector<string> vars;                     // Slot order of the vars argument
+    unordered_map<string, int> slotOf;
+
+    double operator()(const double* values) const {
+        return fn ? fn(values) : runProgram(prog, values, frame.data());
+    }
+};
+
+#if defined(__x86_64__) && (defined(__linux__) || defined(__APPLE__))
+#include <sys/mman.h>   // mmap/mprotect for the executable code buffer
+#define HAVE_JIT 1
+
+// Emits machine code into a byte buffer; xmm registers are numbered 0..15
+struct CodeEmitter {
+    vector<uint8_t> code;
+    unordered_map<const TreeNode*, int> need;   // Registers each subtree needs
+    const unordered_map<string, int>* slotOf;
+    static const size_t MAX_CODE = 16 << 20;    // Shared DAG nodes are expanded; cap the size
+
+    void byte(uint8_t b) { code.push_back(b); }
+    void bytes32(uint32_t v) { for (int i = 0; i < 4; i++) byte(v >> (8 * i)); }
+
+    // Optional REX prefix for an instruction using xmm `reg` (ModRM.reg) and `rm`
+    void rex(bool w, int reg, int rm) {
+        uint8_t r = 0x40 | (w ? 8 : 0) | (reg >= 8 ? 4 : 0) | (rm >= 8 ? 1 : 0);
+        if (r != 0x40) byte(r);
+    }
+
+    // Scalar double op between registers: F2 0F opcode /r (addsd 58, mulsd 59,
+    // subsd 5C, divsd 5E, movsd 10)
+    void sseRegReg(uint8_t opcode, int dst, int src) {
+        byte(0xF2); rex(false, dst, src); byte(0x0F); byte(opcode);
+        byte(0xC0 | ((dst & 7) << 3) | (src & 7));
+    }
+
+    // Same with the operand at [rsp] (ModRM rm=100 + SIB 0x24)
+    void sseRegStack(uint8_t opcode, int reg) {
+        byte(0xF2); rex(false, reg, 0); byte(0x0F); byte(opcode);
+        byte(((reg & 7) << 3) | 4); byte(0x24);
+    }
+
+    // movsd xmm, [rdi + 8 * slot]
+    void loadVariable(int reg, int slot) {
+        byte(0xF2); rex(false, reg, 0); byte(0x0F); byte(0x10);
+        byte(0x80 | ((reg & 7) << 3) | 7);
+        bytes32(8 * slot);
+    }
+
+    // mov rax, imm64; movq xmm, rax
+    void loadNumber(int reg, double value) {
+        uint64_t bits;
+        memcpy(&bits, &value, sizeof(bits));
+        byte(0x48); byte(0xB8);
+        for (int i = 0; i < 8; i++) byte(bits >> (8 * i));
+        byte(0x66); rex(true, reg, 0); byte(0x0F); byte(0x6E); byte(0xC0 | ((reg & 7) << 3));
+    }
+
+    // Flip the sign bit: movq rax, xmm; btc rax, 63; movq xmm, rax
+    void negate(int reg) {
+        byte(0x66); rex(true, reg, 0); byte(0x0F); byte(0x7E); byte(0xC0 | ((reg & 7) << 3));
+        byte(0x48); byte(0x0F); byte(0xBA); byte(0xF8); byte(63);
+        byte(0x66); rex(true, reg, 0); byte(0x0F); byte(0x6E); byte(0xC0 | ((reg & 7) << 3));
+    }
+
+    static uint8_t opcodeOf(char op) {
+        switch (op) {
+            case '+': return 0x58;
+            case '*': return 0x59;
+            case '-': return 0x5C;
+            default:  return 0x5E;           // '/'
+        }
+    }
+
+    // Sethi-Ullman number: registers needed to evaluate the subtree
+    // without spilling (the larger child first, then one more for the other)
+    int registersNeeded(const TreeNode* node) {
+        if (node->kind != NODE_OPERATOR) return 1;
+        auto it = need.find(node);
+        if (it != need.end()) return it->second;
+        int l = registersNeeded(node->left);
+        int n = l;
+        if (node->right && !(node->data == '^')) {
+            int r = registersNeeded(node->right);
+            n = (l == r) ? l + 1 : max(l, r);
+        }
+        need[node] = n;
+        return n;
+    }
+
+    // Emit code leaving the subtree's value in xmm`reg`, using only
+    // registers reg..15; spills to the machine stack when they run out
+    bool generate(const TreeNode* node, int reg) {
+        if (code.size() > MAX_CODE) return false;
+        if (node->kind == NODE_NUMBER) {
+            loadNumber(reg, node->value);
+            return true;
+        }
+        if (node->kind == NODE_VARIABLE) {
+            loadVariable(reg, slotOf->at(node->name));
+            return true;
+        }
+        if (node->data == '~') {
+            if (!generate(node->left, reg)) return false;
+            negate(reg);
+            return true;
+        }
+        if (node->data == '^') {             // Only x^2 is supported (checked by jitSupported)
+            if (!generate(node->left, reg)) return false;
+            sseRegReg(0x59, reg, reg);
+            return true;
+        }
+        uint8_t opcode = opcodeOf(node->data);
+        if (reg == 15) {                     // No spare register: keep the right operand on the stack
+            if (!generate(node->right, reg)) return false;
+            byte(0x48); byte(0x83); byte(0xEC); byte(8);                          // sub rsp, 8
+            byte(0xF2); rex(false, reg, 0); byte(0x0F); byte(0x11); byte(((reg & 7) << 3) | 4); byte(0x24); // movsd [rsp], xmm
+            if (!generate(node->left, reg)) return false;
+            sseRegStack(opcode, reg);                                             // op xmm, [rsp]
+            byte(0x48); byte(0x83); byte(0xC4); byte(8);                          // add rsp, 8
+            return true;
+        }
+        if (registersNeeded(node->left) >= registersNeeded(node->right)) {
+            if (!generate(node->left, reg) || !generate(node->right, reg + 1)) return false;
+            sseRegReg(opcode, reg, reg + 1);
+        } else {                             // Right subtree is bigger: evaluate it first
+            if (!generate(node->right, reg) || !generate(node->left, reg + 1)) return false;
+            sseRegReg(opcode, reg + 1, reg);
+            sseRegReg(0x10, reg, reg + 1);   // movsd: move the result down
+        }
+        return true;
+    }
+};
+#endif
+
+// Function to check that the code generator handles every operator in the tree
+bool jitSupported(TreeNode* root) {
+    stack<TreeNode*> st;
+    st.push(root);
+    while (!st.empty()) {
+        TreeNode* curr = st.top(); st.pop();
+        if (curr->kind == NODE_OPERATOR && curr->data == '^' &&
+            !(curr->right->kind == NODE_NUMBER && curr->right->value == 2))
+            return false;                    // General pow would need a library call
+        if (curr->left) st.push(curr->left);
+        if (curr->right) st.push(curr->right);
+    }
+    return true;
+}
+
+// Function to JIT-compile a tree. Always succeeds in producing something
+// callable; returns false (with a reason) if it had to fall back to the
+// bytecode VM.
+bool jitCompile(TreeNode* root, JitFunction& jit, string& reason) {
+    jit.prog = compileExpression(root);
+    jit.frame.assign(jit.prog.frameSize(), 0);
+    jit.vars = jit.prog.vars;                    // Same slot order as the bytecode
+    jit.slotOf.clear();
+    for (size_t v = 0; v < jit.vars.size(); v++) jit.slotOf[jit.vars[v]] = v;
+#ifdef HAVE_JIT
+    if (treeDepth(root) > MAX_JIT_DEPTH) {       // The code generator recurses once per level
+        reason = "expression nested deeper than " + to_string(MAX_JIT_DEPTH) + " levels";
+        return false;
+    }
+    if (!jitSupported(root)) {
+        reason = "'^' with an exponent other than 2";
+        return false;
+    }
+    CodeEmitter emitter;
+    emitter.slotOf = &jit.slotOf;
+    if (!emitter.generate(root, 0)) {            // Result in xmm0, the return register
+        reason = "generated code too large";
+        return false;
+    }
+    emitter.byte(0xC3);                          // ret
+
+    // Write the code into a writable mapping, then make it executable
+    // (never writable and executable at the same time)
+    size_t size = emitter.code.size();
+    void* mem = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mem == MAP_FAILED) {
+        reason = "mmap failed";
+        return false;
+    }
+    memcpy(mem, emitter.code.data(), size);
+    if (mprotect(mem, size, PROT_READ | PROT_EXEC) != 0) {
+        munmap(mem, size);
+        reason = "mprotect failed";
+        return false;
+    }
+    jit.memory = mem;
+    jit.size = size;
+    jit.fn = (NativeExpression)mem;
+    return true;
+#else
+    reason = "JIT needs x86-64 Linux or macOS";
+    return false;
+#endif
+}
+
+// Function to free the machine code of a compiled expression
+void jitRelease(JitFunction& jit) {
+#ifdef HAVE_JIT
+    if (jit.memory) munmap(jit.memory, jit.size);
+#endif
+    jit.memory = nullptr;
+    jit.fn = nullptr;
+    jit.size = 0;
+}
+
+// Benchmark: tree walking vs. bytecode stack machine vs. JIT native code
+void benchmarkJit(TreeNode* root, int n) {
+    JitFunction jit;
+    string reason;
+    if (jitCompile(root, jit, reason)) cout << "JIT: " << jit.size << " bytes of x86-64 code\n";
+    else cout << "JIT unavailable (" << reason << "), using the bytecode fallback\n";
+    bool walkable = treeDepth(root) <= MAX_JIT_DEPTH;  // evaluateTree recurses once per level
+
+    Program prog = compileExpression(root);
+    vector<Binding> bindings(n);
+    mt19937 rng(29);
+    uniform_real_distribution<double> dist(1.0, 10.0);
+    for (Binding& b : bindings)
+        for (double& v : b.value) v = dist(rng);
+    auto seconds = [](chrono::steady_clock::time_point t) {
+        return chrono::duration<double>(chrono::steady_clock::now() - t).count();
+    };
+
+    vector<double> walked(n), native(n), bytecode;
+    auto start = chrono::steady_clock::now();
+    for (int i = 0; walkable && i < n; i++) walked[i] = evaluateTree(root, bindings[i].value, jit.slotOf);
+    double walkTime = seconds(start);
+
+    start = chrono::steady_clock::now();
+    evaluateBatch(prog, bindings, bytecode);
+    double byteTime = seconds(start);
+
+    start = chrono::steady_clock::now();
+    for (int i = 0; i < n; i++) native[i] = jit(bindings[i].value);
+    double jitTime = seconds(start);
+
+    const vector<double>& expected = walkable ? walked : bytecode;
+    int mismatches = 0;
+    for (int i = 0; i < n; i++)
+        if (fabs(native[i] - expected[i]) > 1e-12 * fabs(expected[i]) && !(native[i] != native[i] && expected[i] != expected[i]))
+            mismatches++;                        // NaN == NaN counts as a match
+    cout << "Evaluations: " << n << "\n";
+    if (walkable) cout << "  Tree walking : " << n / walkTime / 1e6 << " M evaluations/sec\n";
+    else cout << "  Tree walking : skipped (deeper than " << MAX_JIT_DEPTH << " levels)\n";
+    cout << "  Bytecode VM  : " << n / byteTime / 1e6 << " M evaluations/sec\n";
+    cout << "  " << (jit.fn ? "JIT native   : " : "JIT fallback : ") << n / jitTime / 1e6
+         << " M evaluations/sec (" << mismatches << " mismatches)\n";
+    jitRelease(jit);
+}
+
 // Main function with menu-driven interface
 int main() {
     TreeNode* root = nullptr;           // Root pointer of the expression tree
-    string prefix;                      // Variable to store prefix expression from user
+    bool rootIsDag = false;             // True once the tree went through optimizeExpression (shared nodes)
+    string expression;                  // Variable to store expression from user
+    Notation notation = PREFIX;         // Notation the expression is written in
     int choice;                         // Variable to store user menu selection
 
     do {
         // Display menu options to user
         cout << "\n--- Expression Tree Menu ---\n";
-        cout << "1. Enter Prefix Expression\n";
+        cout << "1. Enter Expression (Prefix/Infix/Postfix)\n";
         cout << "2. Construct Expression Tree\n";
         cout << "3. Postorder Traversal (Non-Recursive)\n";
         cout << "4. Delete Expression Tree\n";
-        cout << "5. Exit\n";
+        cout << "5. Evaluate Expression\n";
+        cout << "6. Benchmark Compiled Evaluation\n";
+        cout << "7. Benchmark Columnar (SIMD) Evaluation\n";
+        cout << "8. Optimize Expression Tree (Fold, Simplify, CSE)\n";
+        cout << "9. Benchmark Arena Parsing\n";
+        cout << "10. Benchmark JIT Compiled Evaluation\n";
+        cout << "11. Exit\n";
         cout << "Enter your choice: ";
         cin >> choice;                  // Take user input
 
         switch (choice) {
             case 1:
-                cout << "Enter prefix expression: ";
-                cin >> prefix;         // Store entered prefix expression
+            {
+                int form;
+                cout << "Notation (1 = Prefix, 2 = Infix, 3 = Postfix): ";
+                cin >> form;
+                notation = (form == 2) ? INFIX : (form == 3) ? POSTFIX : PREFIX;
+                cout << "Enter expression: ";
+                cin >> ws;
+                getline(cin, expression);  // Whole line: tokens may be separated by spaces
                 break;
+            }
 
             case 2:
-                if (prefix.empty()) {
-                    cout << "Enter prefix expression first (Option 1).\n";
+                if (expression.empty()) {
+                    cout << "Enter expression first (Option 1).\n";
                 } else {
-                    root = constructExpressionTree(prefix);  // Build expression tree
-                    cout << "Expression tree constructed successfully.\n";
+                    string error;
+                    TreeNode* built = constructExpressionTree(expression, notation, error);  // Build expression tree
+                    if (built && countVariables(built) > (size_t)MAX_VARIABLES) {
+                        error = "At most " + to_string(MAX_VARIABLES) + " distinct variables are supported";
+                        deleteTree(built);
+                        built = nullptr;
+                    }
+                    if (!built) {
+                        cout << "Invalid expression: " << error << "\n";
+                    } else {
+                        rootIsDag ? deleteDag(root) : deleteTree(root);  // Free any previously built tree
+                        root = built;
+                        rootIsDag = false;
+                        cout << "Expression tree constructed successfully (" << countNodes(root) << " nodes).\n";
+                    }
                 }
                 break;
 
@@ -131,20 +1596,93 @@ int main() {
                 if (!root) {
                     cout << "Tree is already deleted or not constructed.\n";
                 } else {
-                    deleteTree(root);         // Delete all nodes in the tree
+                    rootIsDag ? deleteDag(root) : deleteTree(root);  // Delete all nodes in the tree
                     root = nullptr;           // Reset root to null
+                    rootIsDag = false;
                     cout << "Expression tree deleted.\n";
                 }
                 break;
 
             case 5:
+                if (!root) {
+                    cout << "No tree to evaluate. Please construct it first.\n";
+                } else {
+                    Program prog = compileExpression(root);  // Compile once
+                    Binding vars = {};
+                    for (size_t v = 0; v < prog.vars.size(); v++) {  // Each variable is asked once
+                        cout << "Enter value of " << prog.vars[v] << ": ";
+                        cin >> vars.value[v];
+                    }
+                    cout << "Result: " << evaluate(prog, vars) << endl;
+                }
+                break;
+
+            case 6:
+                if (!root) {
+                    cout << "No tree to evaluate. Please construct it first.\n";
+                } else {
+                    int n;
+                    cout << "Enter number of random bindings (e.g. 10000000): ";
+                    cin >> n;
+                    if (n > 0) benchmarkEvaluation(root, n);
+                }
+                break;
+
+            case 7:
+                if (!root) {
+                    cout << "No tree to evaluate. Please construct it first.\n";
+                } else {
+                    long long rows;
+                    cout << "Enter number of rows (e.g. 100000000): ";
+                    cin >> rows;
+                    if (rows > 0) benchmarkColumns(root, rows);
+                }
+                break;
+
+            case 8:
+                if (!root) {
+                    cout << "No tree to optimize. Please construct it first.\n";
+                } else {
+                    size_t before = countNodes(root);
+                    TreeNode* optimized = optimizeExpression(root);
+                    rootIsDag ? deleteDag(root) : deleteTree(root);  // The old tree is no longer needed
+                    root = optimized;
+                    rootIsDag = true;
+                    cout << "Nodes: " << before << " -> " << countNodes(root) << "\n";
+                    cout << "Optimized postorder: ";
+                    postOrderTraversal(root);
+                }
+                break;
+
+            case 9: {
+                int count;
+                cout << "Enter number of expressions (e.g. 200000): ";
+                cin >> count;
+                if (count > 0) benchmarkParsing(count, notation);  // Uses the notation chosen in option 1
+                break;
+            }
+
+            case 10:
+                if (!root) {
+                    cout << "No tree to evaluate. Please construct it first.\n";
+                } else {
+                    int n;
+                    cout << "Enter number of random bindings (e.g. 10000000): ";
+                    cin >> n;
+                    if (n > 0) benchmarkJit(root, n);
+                }
+                break;
+
+            case 11:
                 cout << "Exiting program.\n";
                 break;
 
             default:
                 cout << "Invalid choice. Please select again.\n";
         }
-    } while (choice != 5);              // Repeat menu until user chooses to exit
+    } while (choice != 11);              // Repeat menu until user chooses to exit
+
+    rootIsDag ? deleteDag(root) : deleteTree(root);  // Free the tree before exiting
 
     return 0;
 }
@@ -159,11 +1697,21 @@ Conceptual Explanation:
 
 2. Prefix Expression:
    - Operators precede their operands. Example: +--a*bc/def
+   - Written without spaces every letter is one operand (as above); with
+     spaces, tokens can be numbers and longer names: * + rate 2 x
 
 3. Tree Construction:
-   - Constructed from prefix by scanning right to left.
+   - A tokenizer splits the text into numbers, identifiers, operators
+     (+ - * / ^, and ~ for unary minus) and parentheses.
+   - Prefix is scanned right to left, postfix left to right.
    - Operands become leaf nodes directly.
-   - Operators create new internal nodes by attaching two top stack nodes as children.
+   - Operators create new internal nodes by attaching the top stack nodes as children.
+   - Infix uses the shunting-yard algorithm: an operator stack delays each
+     operator until everything of higher precedence has been attached.
+     ^ binds tightest and is right associative (2^3^2 = 2^9); a '-' where an
+     operand is expected is unary minus, binding looser than ^ (-x^2 = -(x^2)).
+   - Malformed input (missing operand, unmatched parenthesis...) is reported
+     and every node built so far is freed.
 
 4. Postorder Traversal (Non-Recursive):
    - Traverse left subtree, then right subtree, then root.
@@ -175,4 +1723,75 @@ Conceptual Explanation:
 
 6. Stack:
    - LIFO structure is ideal for handling tree building and traversal tasks efficiently.
+
+7. Compiled Evaluation (bytecode + stack machine):
+   - The tree is compiled once: its postorder sequence becomes a flat array
+     of instructions (LOAD variable, ADD, SUB, MUL, DIV) — postfix notation.
+   - A stack machine runs the array: LOAD pushes a value, an operator pops
+     right and left operands and pushes (left op right).
+   - The largest stack depth is computed at compile time, so one stack
+     buffer is allocated per batch, not per evaluation.
+   - Evaluating many bindings (values for a..z) never touches the tree
+     again: a sequential scan over a small array instead of pointer chasing.
+   - Time: O(n) to compile, O(n) per evaluation; Space: O(n) for the code.
+   - A subexpression shared by several parents is computed once, kept in
+     a temporary slot (SAVE) and pushed again where reused (TEMP).
+   - Equal numbers share one constant (CONST), so a block of columnar
+     evaluation holds each distinct constant once.
+
+8. Columnar (vectorized) Evaluation:
+   - When the data is stored as columns (one array per variable), each
+     instruction is applied to a block of 1024 rows at once instead of
+     running the whole program for every row.
+   - LOAD just points at the column slice (no copy); an operator writes
+     its block into a scratch buffer belonging to its stack level.
+   - The per-instruction loops are simple element-wise array operations,
+     run with AVX2 (4 doubles per instruction) when the CPU supports it,
+     chosen at run time, with a portable scalar loop as fallback.
+   - The interpretation overhead is paid once per block, not once per row,
+     so throughput approaches memory bandwidth (reported in GB/s).
+
+9. Optimization (constant folding, simplification, CSE):
+   - Bottom-up pass: children are optimized before their parent.
+   - Constant folding: an operator whose operands are all numbers is
+     replaced by its value: 2*3+x becomes 6+x.
+   - Algebraic identities: x+0, 0+x, x-0, x*1, 1*x, x/1, x^1 become x;
+     x^0 and 1^x become 1; -(-x) becomes x. (x*0 is kept: it is not 0
+     when x is infinite or NaN.)
+   - Common subexpression elimination by hash-consing: every node is looked
+     up by (operator, children) in a hash table, and an identical node that
+     already exists is reused. Repeated subexpressions such as (a+b) in
+     (a+b)*(a+b) then exist only once, turning the tree into a DAG.
+   - Deleting a DAG must free a shared node only once, so deleteDag
+     remembers the nodes it has already visited. Plain parsed trees are
+     freed by deleteTree, which needs no such set.
+
+10. Arena Allocation:
+   - Every TreeNode is a separate heap allocation (about 64 bytes with its
+     name string), and deleting a tree frees them one by one.
+   - The arena stores nodes in one vector; children are 32-bit indices
+     rather than 8-byte pointers, so a node is 16 bytes and the nodes of
+     a tree sit next to each other in memory.
+   - Names and numbers go to side buffers; the parse stacks and token list
+     are kept in the arena and reused, so after warm-up parsing allocates
+     nothing.
+   - Destroying all trees is reset(): the vectors are cleared in O(1) but
+     keep their capacity. A failed parse just truncates back to where it began.
+
+11. JIT Compilation (x86-64):
+   - The tree is translated straight into machine code: a variable is a
+     load from the vars array, a number is an immediate, an operator is one
+     SSE2 instruction (addsd, subsd, mulsd, divsd); the result is returned in xmm0.
+   - Register allocation follows the tree shape (Sethi-Ullman numbering):
+     the child needing more registers is evaluated first, so a subtree of
+     need k fits in k registers. With all 16 xmm registers in use, the
+     right operand is spilled to the machine stack.
+   - The code is written to an mmap'd buffer that is then switched from
+     writable to executable, and called through a function pointer.
+   - No loads of opcodes, no dispatch, no operand stack in memory: the
+     remaining cost is the call itself and the arithmetic.
+   - General x^y would need a call to pow, so only x^2 is compiled (as
+     x*x); other trees, trees deeper than 10000 levels (the generator
+     recurses once per level) and non-x86-64 builds run the bytecode VM
+     instead, which has no recursion.
 */
@@ -1,7 +1,19 @@
 #include <iostream>                     // For standard input and output
 #include <string>                       // For using string data type
+#include <vector>                       // For key lists used by the benchmark
+#include <stack>                        // For iterative tree destruction
+#include <cstdint>                      // For uint64_t key prefixes
+#include <chrono>                       // For timing the benchmark
+#include <random>                       // For shuffling benchmark lookups
+#include <algorithm>                    // For shuffle
+#include <queue>                        // For level-order height computation
+#include <fstream>                      // For dictionary snapshot files
+#include <cstring>                      // For memcpy when decoding snapshots
+#include "dictionary_stats.h"           // Shared comparison/latency instrumentation
 using namespace std;
 
+DictionaryStats dictStats;              // Instrumentation for the active dictionary
+
 // Structure to represent a dictionary node
 struct Node {
     string key;                         // The keyword (key)
@@ -24,6 +36,7 @@ Node* insert(Node* root, Node* temp) {
     if (root == nullptr) {
         return temp;                   // If tree is empty, new node becomes root
     }
+    dictStats.comparisons++;           // One key comparison per visited node
     if (temp->key < root->key) {       // If key is smaller, go left
         root->left = insert(root->left, temp);
     } else if (temp->key > root->key) {// If key is greater, go right
@@ -52,20 +65,48 @@ void reverseInorder(Node* root) {
     }
 }
 
-// Function to search a keyword and count comparisons
-int search(Node* root, string key, int& comparisons) {
+// Function to compute the height of the BST level by level (no recursion)
+int treeHeight(Node* root) {
+    int height = 0;
+    queue<Node*> q;
+    if (root != nullptr) q.push(root);
+    while (!q.empty()) {
+        height++;                      // One more level
+        for (int size = q.size(); size > 0; size--) {
+            Node* curr = q.front(); q.pop();
+            if (curr->left) q.push(curr->left);
+            if (curr->right) q.push(curr->right);
+        }
+    }
+    return height;
+}
+
+// Function to locate a keyword without printing (counts comparisons)
+Node* findNode(Node* root, const string& key, int& comparisons) {
     while (root != nullptr) {
         comparisons++;                 // Increment comparison count
+        dictStats.comparisons++;
         if (key == root->key) {
-            cout << "Found: " << root->meaning << endl;
-            return comparisons;
+            return root;               // Keyword found
         } else if (key < root->key) {
             root = root->left;         // Search in left subtree
         } else {
             root = root->right;        // Search in right subtree
         }
     }
-    cout << "Keyword not found.\n";
+    return nullptr;                    // Keyword not present
+}
+
+// Function to search a keyword and count comparisons
+int search(Node* root, string key, int& comparisons) {
+    OpTimer timer(dictStats);
+    Node* found = findNode(root, key, comparisons);
+    timer.finish(OP_SEARCH, [&] { return treeHeight(root); });
+    if (found != nullptr) {
+        cout << "Found: " << found->meaning << endl;
+    } else {
+        cout << "Keyword not found.\n";
+    }
     return comparisons;
 }
 
@@ -79,6 +120,7 @@ Node* findMin(Node* root) {
 Node* deleteNode(Node* root, string key) {
     if (root == nullptr) return root;
 
+    dictStats.comparisons++;
     if (key < root->key) {
         root->left = deleteNode(root->left, key); // Go left
     } else if (key > root->key) {
@@ -120,14 +162,1160 @@ void update(Node* root, string key) {
     cout << "Keyword not found.\n";
 }
 
+// Function to free every node of the BST (iterative, safe for degenerate trees)
+void destroyTree(Node* root) {
+    stack<Node*> st;
+    if (root != nullptr) st.push(root);
+    while (!st.empty()) {
+        Node* curr = st.top(); st.pop();
+        if (curr->left) st.push(curr->left);
+        if (curr->right) st.push(curr->right);
+        delete curr;
+    }
+}
+
+// Function to count bytes used by the BST (nodes plus string heap storage)
+size_t bstMemory(Node* root) {
+    size_t bytes = 0;
+    stack<Node*> st;
+    if (root != nullptr) st.push(root);
+    while (!st.empty()) {
+        Node* curr = st.top(); st.pop();
+        bytes += sizeof(Node) + stringHeapBytes(curr->key) + stringHeapBytes(curr->meaning);
+        if (curr->left) st.push(curr->left);
+        if (curr->right) st.push(curr->right);
+    }
+    return bytes;
+}
+
+// ---------------------------------------------------------------------------
+// Snapshot file: the BST in pre-order, one record per node:
+//   flags (1 byte: bit 0 = has left child, bit 1 = has right child)
+//   key length (4 bytes) + key bytes, meaning length (4 bytes) + meaning bytes
+// preceded by a header "BSTD", format version and node count. Because the
+// child flags describe the shape exactly, loading rebuilds the same tree
+// without a single key comparison.
+// ---------------------------------------------------------------------------
+
+const char SNAPSHOT_MAGIC[4] = {'B', 'S', 'T', 'D'};
+const uint32_t SNAPSHOT_VERSION = 1;
+
+// Append a length-prefixed string to the output file
+void writeString(ofstream& out, const string& str) {
+    uint32_t len = str.size();
+    out.write((const char*)&len, sizeof(len));
+    out.write(str.data(), len);
+}
+
+// Function to save the BST to a snapshot file; returns false on I/O error
+bool save(Node* root, const string& path) {
+    ofstream out(path, ios::binary | ios::trunc);
+    if (!out) return false;
+
+    uint64_t count = 0;                                // Patched in after the walk
+    out.write(SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+    out.write((const char*)&SNAPSHOT_VERSION, sizeof(SNAPSHOT_VERSION));
+    streampos countPos = out.tellp();
+    out.write((const char*)&count, sizeof(count));
+
+    stack<Node*> st;                                   // Iterative pre-order walk
+    if (root != nullptr) st.push(root);
+    while (!st.empty()) {
+        Node* curr = st.top(); st.pop();
+        char flags = (curr->left ? 1 : 0) | (curr->right ? 2 : 0);
+        out.put(flags);
+        writeString(out, curr->key);
+        writeString(out, curr->meaning);
+        count++;
+        if (curr->right) st.push(curr->right);         // Right is visited after left
+        if (curr->left) st.push(curr->left);
+    }
+
+    out.seekp(countPos);
+    out.write((const char*)&count, sizeof(count));
+    return (bool)out;
+}
+
+// Read a length-prefixed string from buf at pos; false if it runs past the end
+bool readString(const vector<char>& buf, size_t& pos, string& str) {
+    uint32_t len;
+    if (buf.size() - pos < sizeof(len)) return false;
+    memcpy(&len, &buf[pos], sizeof(len));
+    pos += sizeof(len);
+    if (buf.size() - pos < len) return false;
+    str.assign(&buf[pos], len);
+    pos += len;
+    return true;
+}
+
+// Function to load a snapshot written by save(). The whole file is read with
+// one sequential read, then the tree is rebuilt from the child flags.
+// On success the old tree is freed and replaced; on failure it is kept.
+bool load(const string& path, Node*& root, uint64_t& count) {
+    ifstream in(path, ios::binary | ios::ate);
+    if (!in) return false;
+    vector<char> buf((size_t)in.tellg());
+    in.seekg(0);
+    if (!in.read(buf.data(), buf.size())) return false;
+
+    size_t pos = sizeof(SNAPSHOT_MAGIC) + sizeof(SNAPSHOT_VERSION) + sizeof(count);
+    uint32_t version;
+    if (buf.size() < pos || memcmp(buf.data(), SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) != 0) return false;
+    memcpy(&version, &buf[sizeof(SNAPSHOT_MAGIC)], sizeof(version));
+    memcpy(&count, &buf[sizeof(SNAPSHOT_MAGIC) + sizeof(version)], sizeof(count));
+    if (version != SNAPSHOT_VERSION) return false;
+
+    Node* newRoot = nullptr;
+    Node* parent = nullptr;            // Node the next record attaches to
+    bool asLeft = false;               // Attach as left (true) or right (false) child
+    stack<Node*> pendingRight;         // Nodes whose right subtree is still to come
+    uint64_t openSlots = (count > 0);  // Child links announced but not yet filled
+    bool ok = true;
+
+    for (uint64_t i = 0; i < count; i++) {
+        if (pos >= buf.size() || openSlots == 0 || (buf[pos] & ~3) != 0) { ok = false; break; }
+        char flags = buf[pos++];
+        openSlots += (flags & 1) + ((flags >> 1) & 1) - 1;
+        Node* node = createNode("", "");
+        if (!readString(buf, pos, node->key) || !readString(buf, pos, node->meaning)) {
+            delete node;
+            ok = false;
+            break;
+        }
+        if (parent == nullptr) newRoot = node;
+        else if (asLeft) parent->left = node;
+        else parent->right = node;
+
+        if (flags & 1) {               // Next record is this node's left child
+            if (flags & 2) pendingRight.push(node);
+            parent = node;
+            asLeft = true;
+        } else if (flags & 2) {        // Next record is this node's right child
+            parent = node;
+            asLeft = false;
+        } else if (!pendingRight.empty()) { // Leaf: resume the nearest pending right subtree
+            parent = pendingRight.top(); pendingRight.pop();
+            asLeft = false;
+        }
+    }
+    if (openSlots != 0) ok = false;    // Records ran out while children were still expected
+    if (!ok) {
+        destroyTree(newRoot);
+        return false;
+    }
+    destroyTree(root);
+    root = newRoot;
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// B-Tree dictionary: cache-conscious alternative to the BST above.
+// Each node keeps up to BT_MAX_KEYS sorted keys, so a lookup touches one node
+// per level of a very shallow tree instead of one heap node per comparison.
+// ---------------------------------------------------------------------------
+
+const int BT_MIN_DEGREE = 8;                    // t: non-root nodes hold t-1 .. 2t-1 keys
+const int BT_MAX_KEYS = 2 * BT_MIN_DEGREE - 1;  // 15 keys per node
+
+// Node of the B-Tree. The 8-byte key prefixes come first so that the scan
+// inside a node reads two contiguous cache lines; full keys are only touched
+// when two prefixes tie.
+struct alignas(64) BTreeNode {
+    uint64_t prefix[BT_MAX_KEYS];       // First 8 bytes of each key (big-endian)
+    int n;                              // Number of keys currently stored
+    bool leaf;                          // True if node has no children
+    BTreeNode* child[BT_MAX_KEYS + 1];  // Child pointers (n + 1 used when internal)
+    string key[BT_MAX_KEYS];            // Keywords (short ones live inline via SSO)
+    string meaning[BT_MAX_KEYS];        // Meanings associated with the keywords
+};
+
+// Pack the first 8 bytes of a key so that integer order equals string order
+uint64_t keyPrefix(const string& key) {
+    uint64_t p = 0;
+    for (int i = 0; i < 8; i++) {
+        p <<= 8;
+        if (i < (int)key.size()) p |= (unsigned char)key[i];
+    }
+    return p;
+}
+
+// Compare key (with precomputed prefix) against slot i: <0, 0 or >0
+int btCompare(const BTreeNode* x, int i, const string& key, uint64_t p) {
+    if (p != x->prefix[i]) return p < x->prefix[i] ? -1 : 1; // Decided by prefix alone
+    return key.compare(x->key[i]);                           // Tie: compare full strings
+}
+
+// Function to create an empty B-Tree node
+BTreeNode* createBTreeNode(bool leaf) {
+    BTreeNode* node = new BTreeNode();
+    node->n = 0;
+    node->leaf = leaf;
+    for (int i = 0; i <= BT_MAX_KEYS; i++) node->child[i] = nullptr;
+    return node;
+}
+
+// Move slot `from` of node a into slot `to` of node b (key, meaning and prefix)
+void btMoveKey(BTreeNode* a, int from, BTreeNode* b, int to) {
+    b->prefix[to] = a->prefix[from];
+    b->key[to] = move(a->key[from]);
+    b->meaning[to] = move(a->meaning[from]);
+}
+
+// Index of the first key >= key inside node x (comparisons are counted)
+int btLowerBound(const BTreeNode* x, const string& key, uint64_t p, int& comparisons, int& cmp) {
+    int i = 0;
+    cmp = 1;
+    while (i < x->n) {
+        comparisons++;
+        dictStats.comparisons++;
+        cmp = btCompare(x, i, key, p);
+        if (cmp <= 0) break;           // Stop at first key not smaller than target
+        i++;
+    }
+    return i;
+}
+
+// Function to locate a keyword in the B-Tree; sets idx to its slot
+BTreeNode* btFind(BTreeNode* root, const string& key, int& idx, int& comparisons) {
+    uint64_t p = keyPrefix(key);
+    BTreeNode* x = root;
+    while (x != nullptr) {
+        int cmp;
+        int i = btLowerBound(x, key, p, comparisons, cmp);
+        if (i < x->n && cmp == 0) {
+            idx = i;
+            return x;                  // Keyword found in this node
+        }
+        x = x->leaf ? nullptr : x->child[i]; // Descend into the covering child
+    }
+    return nullptr;
+}
+
+// Function to compute the height of the B-Tree (all leaves share one depth)
+int btHeight(BTreeNode* x) {
+    int height = 0;
+    while (x != nullptr) {
+        height++;
+        x = x->leaf ? nullptr : x->child[0];
+    }
+    return height;
+}
+
+// Function to search a keyword in the B-Tree and count comparisons
+int btSearch(BTreeNode* root, string key, int& comparisons) {
+    int idx;
+    OpTimer timer(dictStats);
+    BTreeNode* x = btFind(root, key, idx, comparisons);
+    timer.finish(OP_SEARCH, [&] { return btHeight(root); });
+    if (x != nullptr) {
+        cout << "Found: " << x->meaning[idx] << endl;
+    } else {
+        cout << "Keyword not found.\n";
+    }
+    return comparisons;
+}
+
+// Split the full child y = x->child[i] around its median key
+void btSplitChild(BTreeNode* x, int i) {
+    BTreeNode* y = x->child[i];
+    BTreeNode* z = createBTreeNode(y->leaf);
+    const int t = BT_MIN_DEGREE;
+    z->n = t - 1;
+    for (int j = 0; j < t - 1; j++) btMoveKey(y, j + t, z, j);    // Upper half of keys
+    if (!y->leaf)
+        for (int j = 0; j < t; j++) z->child[j] = y->child[j + t]; // Upper half of children
+    y->n = t - 1;
+
+    for (int j = x->n; j >= i + 1; j--) x->child[j + 1] = x->child[j];
+    x->child[i + 1] = z;
+    for (int j = x->n - 1; j >= i; j--) btMoveKey(x, j, x, j + 1);
+    btMoveKey(y, t - 1, x, i);                                   // Median moves up
+    x->n++;
+}
+
+// Insert into a node that is known not to be full
+void btInsertNonFull(BTreeNode* x, const string& key, const string& meaning, uint64_t p) {
+    int comparisons = 0, cmp;
+    while (!x->leaf) {
+        int i = btLowerBound(x, key, p, comparisons, cmp);
+        if (x->child[i]->n == BT_MAX_KEYS) {
+            btSplitChild(x, i);        // Split before descending so parent never overflows
+            if (btCompare(x, i, key, p) > 0) i++;
+        }
+        x = x->child[i];
+    }
+    int i = btLowerBound(x, key, p, comparisons, cmp);
+    for (int j = x->n - 1; j >= i; j--) btMoveKey(x, j, x, j + 1); // Make room
+    x->prefix[i] = p;
+    x->key[i] = key;
+    x->meaning[i] = meaning;
+    x->n++;
+}
+
+// Function to insert a keyword into the B-Tree (duplicates are rejected)
+BTreeNode* btInsert(BTreeNode* root, string key, string meaning) {
+    int idx, comparisons = 0;
+    if (btFind(root, key, idx, comparisons) != nullptr) {
+        cout << "Duplicate key. Not inserting.\n";
+        return root;
+    }
+    if (root == nullptr) root = createBTreeNode(true);
+    if (root->n == BT_MAX_KEYS) {      // Root is full: tree grows in height
+        BTreeNode* s = createBTreeNode(false);
+        s->child[0] = root;
+        btSplitChild(s, 0);
+        root = s;
+    }
+    btInsertNonFull(root, key, meaning, keyPrefix(key));
+    return root;
+}
+
+// Merge child i+1 and separator key i of x into child i
+void btMerge(BTreeNode* x, int i) {
+    BTreeNode* c = x->child[i];
+    BTreeNode* s = x->child[i + 1];
+    btMoveKey(x, i, c, c->n);                          // Separator comes down
+    for (int j = 0; j < s->n; j++) btMoveKey(s, j, c, c->n + 1 + j);
+    if (!c->leaf)
+        for (int j = 0; j <= s->n; j++) c->child[c->n + 1 + j] = s->child[j];
+    c->n += s->n + 1;
+
+    for (int j = i + 1; j < x->n; j++) btMoveKey(x, j, x, j - 1);
+    for (int j = i + 2; j <= x->n; j++) x->child[j - 1] = x->child[j];
+    x->n--;
+    delete s;
+}
+
+// Ensure child i of x has at least t keys before descending into it
+int btFill(BTreeNode* x, int i) {
+    const int t = BT_MIN_DEGREE;
+    if (i > 0 && x->child[i - 1]->n >= t) {            // Borrow from left sibling
+        BTreeNode* c = x->child[i];
+        BTreeNode* l = x->child[i - 1];
+        for (int j = c->n - 1; j >= 0; j--) btMoveKey(c, j, c, j + 1);
+        if (!c->leaf)
+            for (int j = c->n; j >= 0; j--) c->child[j + 1] = c->child[j];
+        btMoveKey(x, i - 1, c, 0);
+        if (!c->leaf) c->child[0] = l->child[l->n];
+        btMoveKey(l, l->n - 1, x, i - 1);
+        c->n++;
+        l->n--;
+    } else if (i < x->n && x->child[i + 1]->n >= t) {  // Borrow from right sibling
+        BTreeNode* c = x->child[i];
+        BTreeNode* r = x->child[i + 1];
+        btMoveKey(x, i, c, c->n);
+        if (!c->leaf) c->child[c->n + 1] = r->child[0];
+        btMoveKey(r, 0, x, i);
+        for (int j = 1; j < r->n; j++) btMoveKey(r, j, r, j - 1);
+        if (!r->leaf)
+            for (int j = 1; j <= r->n; j++) r->child[j - 1] = r->child[j];
+        c->n++;
+        r->n--;
+    } else if (i < x->n) {                             // Merge with right sibling
+        btMerge(x, i);
+    } else {                                           // Merge with left sibling
+        btMerge(x, i - 1);
+        i--;
+    }
+    return i;
+}
+
+// Remove key from the subtree rooted at x (single downward pass)
+void btRemove(BTreeNode* x, const string& key, uint64_t p) {
+    const int t = BT_MIN_DEGREE;
+    int comparisons = 0, cmp;
+    int i = btLowerBound(x, key, p, comparisons, cmp);
+
+    if (i < x->n && cmp == 0) {
+        if (x->leaf) {                                 // Case 1: key in leaf
+            for (int j = i + 1; j < x->n; j++) btMoveKey(x, j, x, j - 1);
+            x->n--;
+        } else if (x->child[i]->n >= t) {              // Case 2a: use predecessor
+            BTreeNode* cur = x->child[i];
+            while (!cur->leaf) cur = cur->child[cur->n];
+            x->prefix[i] = cur->prefix[cur->n - 1];
+            x->key[i] = cur->key[cur->n - 1];
+            x->meaning[i] = cur->meaning[cur->n - 1];
+            btRemove(x->child[i], x->key[i], x->prefix[i]);
+        } else if (x->child[i + 1]->n >= t) {          // Case 2b: use successor
+            BTreeNode* cur = x->child[i + 1];
+            while (!cur->leaf) cur = cur->child[0];
+            x->prefix[i] = cur->prefix[0];
+            x->key[i] = cur->key[0];
+            x->meaning[i] = cur->meaning[0];
+            btRemove(x->child[i + 1], x->key[i], x->prefix[i]);
+        } else {                                       // Case 2c: merge and recurse
+            btMerge(x, i);
+            btRemove(x->child[i], key, p);
+        }
+        return;
+    }
+
+    if (x->leaf) {
+        cout << "Keyword not found.\n";
+        return;
+    }
+    if (x->child[i]->n < t) i = btFill(x, i);          // Case 3: top up child first
+    btRemove(x->child[i], key, p);
+}
+
+// Function to delete a keyword from the B-Tree; returns the (possibly new) root
+BTreeNode* btDeleteNode(BTreeNode* root, string key) {
+    if (root == nullptr) return root;
+    btRemove(root, key, keyPrefix(key));
+    if (root->n == 0) {                                // Root emptied: shrink height
+        BTreeNode* old = root;
+        root = root->leaf ? nullptr : root->child[0];
+        delete old;
+    }
+    return root;
+}
+
+// Function to update the meaning of an existing keyword in the B-Tree
+void btUpdate(BTreeNode* root, string key) {
+    int idx, comparisons = 0;
+    BTreeNode* x = btFind(root, key, idx, comparisons);
+    if (x == nullptr) {
+        cout << "Keyword not found.\n";
+        return;
+    }
+    cout << "Enter new meaning: ";
+    getline(cin, x->meaning[idx]);
+    cout << "Updated successfully.\n";
+}
+
+// Function to print the B-Tree in ascending order
+void btInorder(BTreeNode* x) {
+    if (x == nullptr) return;
+    for (int i = 0; i < x->n; i++) {
+        if (!x->leaf) btInorder(x->child[i]);
+        cout << x->key[i] << ": " << x->meaning[i] << endl;
+    }
+    if (!x->leaf) btInorder(x->child[x->n]);
+}
+
+// Function to print the B-Tree in descending order
+void btReverseInorder(BTreeNode* x) {
+    if (x == nullptr) return;
+    if (!x->leaf) btReverseInorder(x->child[x->n]);
+    for (int i = x->n - 1; i >= 0; i--) {
+        cout << x->key[i] << ": " << x->meaning[i] << endl;
+        if (!x->leaf) btReverseInorder(x->child[i]);
+    }
+}
+
+// Function to count bytes used by the B-Tree (nodes plus string heap storage)
+size_t btMemory(BTreeNode* x) {
+    if (x == nullptr) return 0;
+    size_t bytes = sizeof(BTreeNode);
+    for (int i = 0; i < x->n; i++) bytes += stringHeapBytes(x->key[i]) + stringHeapBytes(x->meaning[i]);
+    if (!x->leaf)
+        for (int i = 0; i <= x->n; i++) bytes += btMemory(x->child[i]);
+    return bytes;
+}
+
+// Function to free every node of the B-Tree
+void btDestroy(BTreeNode* x) {
+    if (x == nullptr) return;
+    if (!x->leaf)
+        for (int i = 0; i <= x->n; i++) btDestroy(x->child[i]);
+    delete x;
+}
+
+// ---------------------------------------------------------------------------
+// Splay tree dictionary: same Node as the BST, but every access moves the
+// touched key to the root (top-down splaying), so frequently used keywords
+// stay near the top and skewed lookups become cheap.
+// ---------------------------------------------------------------------------
+
+// Top-down splay: reorganise the tree so that key (or the last node on its
+// search path) becomes the root. Counts one comparison per examined node.
+Node* splay(Node* root, const string& key, int& comparisons) {
+    if (root == nullptr) return root;
+    Node header;                           // Holds the left and right trees being built
+    header.left = header.right = nullptr;
+    Node* leftMax = &header;               // Largest node of the left tree
+    Node* rightMin = &header;              // Smallest node of the right tree
+
+    while (true) {
+        comparisons++;
+        dictStats.comparisons++;
+        if (key < root->key) {
+            if (root->left == nullptr) break;
+            comparisons++;
+            dictStats.comparisons++;
+            if (key < root->left->key) {   // Zig-zig: rotate right first
+                Node* temp = root->left;
+                root->left = temp->right;
+                temp->right = root;
+                root = temp;
+                dictStats.rotations++;
+                if (root->left == nullptr) break;
+            }
+            rightMin->left = root;         // Link root into the right tree
+            rightMin = root;
+            root = root->left;
+        } else if (key > root->key) {
+            if (root->right == nullptr) break;
+            comparisons++;
+            dictStats.comparisons++;
+            if (key > root->right->key) {  // Zag-zag: rotate left first
+                Node* temp = root->right;
+                root->right = temp->left;
+                temp->left = root;
+                root = temp;
+                dictStats.rotations++;
+                if (root->right == nullptr) break;
+            }
+            leftMax->right = root;         // Link root into the left tree
+            leftMax = root;
+            root = root->right;
+        } else {
+            break;                         // Key is at the root
+        }
+    }
+    leftMax->right = root->left;           // Reassemble left, middle and right trees
+    rightMin->left = root->right;
+    root->left = header.right;
+    root->right = header.left;
+    return root;
+}
+
+// Function to insert a node into the splay tree (new key becomes the root)
+Node* splayInsert(Node* root, Node* temp) {
+    if (root == nullptr) return temp;
+    int comparisons = 0;
+    root = splay(root, temp->key, comparisons);
+    if (temp->key == root->key) {
+        cout << "Duplicate key. Not inserting.\n"; // Reject duplicates
+        delete temp;
+        return root;
+    }
+    if (temp->key < root->key) {           // Root becomes right child of new node
+        temp->left = root->left;
+        temp->right = root;
+        root->left = nullptr;
+    } else {                               // Root becomes left child of new node
+        temp->right = root->right;
+        temp->left = root;
+        root->right = nullptr;
+    }
+    return temp;
+}
+
+// Function to look up a key; the key (if present) is splayed to the root
+Node* splayFind(Node*& root, const string& key, int& comparisons) {
+    root = splay(root, key, comparisons);
+    return (root != nullptr && root->key == key) ? root : nullptr;
+}
+
+// Function to search a keyword in the splay tree and count comparisons
+int splaySearch(Node*& root, string key, int& comparisons) {
+    OpTimer timer(dictStats);
+    Node* found = splayFind(root, key, comparisons);
+    timer.finish(OP_SEARCH, [&] { return treeHeight(root); });
+    if (found != nullptr) {
+        cout << "Found: " << found->meaning << endl;
+    } else {
+        cout << "Keyword not found.\n";
+    }
+    return comparisons;
+}
+
+// Function to delete a keyword from the splay tree
+Node* splayDelete(Node* root, string key) {
+    int comparisons = 0;
+    if (splayFind(root, key, comparisons) == nullptr) return root; // Not present
+    Node* temp = root;
+    if (root->left == nullptr) {
+        root = root->right;
+    } else {
+        // Splaying the left subtree for key brings its maximum to the top,
+        // which then has no right child and can adopt the right subtree
+        root = splay(root->left, key, comparisons);
+        root->right = temp->right;
+    }
+    delete temp;
+    return root;
+}
+
+// Function to update the meaning of a keyword in the splay tree
+void splayUpdate(Node*& root, string key) {
+    int comparisons = 0;
+    if (splayFind(root, key, comparisons) == nullptr) {
+        cout << "Keyword not found.\n";
+        return;
+    }
+    cout << "Enter new meaning: ";
+    getline(cin, root->meaning);
+    cout << "Updated successfully.\n";
+}
+
+// ---------------------------------------------------------------------------
+// Radix tree dictionary (Adaptive Radix Tree): keys are consumed one byte per
+// level and shared prefixes are stored once in the inner node ("path
+// compression"), so a lookup does one byte test per level plus a single full
+// key comparison at the leaf instead of a full string comparison per node.
+// Inner nodes come in four sizes (4, 16, 48 and 256 children) and grow or
+// shrink as children are added or removed. Also supports prefix scans.
+// ---------------------------------------------------------------------------
+
+// Leaf: holds the complete key, so a leaf can hang directly below the byte
+// where its key first differs from all others (no chain of one-child nodes)
+struct ArtLeaf {
+    string key;
+    string meaning;
+};
+
+enum ArtType { ART4, ART16, ART48, ART256 };
+
+// Common header of all inner nodes
+struct ArtNode {
+    uint8_t type;                      // ART4, ART16, ART48 or ART256
+    uint16_t count;                    // Number of children
+    string prefix;                     // Compressed path below the parent's byte
+    ArtLeaf* value;                    // Key that ends exactly at this node (if any)
+};
+
+struct ArtNode4 : ArtNode {            // Up to 4 children, keys kept sorted
+    unsigned char keys[4];
+    ArtNode* child[4];
+};
+
+struct ArtNode16 : ArtNode {           // Up to 16 children, keys kept sorted
+    unsigned char keys[16];
+    ArtNode* child[16];
+};
+
+struct ArtNode48 : ArtNode {           // Up to 48 children, byte -> slot index
+    unsigned char index[256];          // 0 = no child, else slot + 1
+    ArtNode* child[48];
+};
+
+struct ArtNode256 : ArtNode {          // Direct array indexed by the byte
+    ArtNode* child[256];
+};
+
+// Child pointers may point to a leaf instead of an inner node; leaves are
+// told apart by setting the lowest pointer bit (both types are aligned)
+bool artIsLeaf(ArtNode* p) { return ((uintptr_t)p & 1) != 0; }
+ArtLeaf* artAsLeaf(ArtNode* p) { return (ArtLeaf*)((uintptr_t)p & ~(uintptr_t)1); }
+ArtNode* artTagLeaf(ArtLeaf* leaf) { return (ArtNode*)((uintptr_t)leaf | 1); }
+
+// Function to create an empty inner node of the given size class
+ArtNode* artNewNode(ArtType type) {
+    ArtNode* n;
+    switch (type) {
+        case ART4:   n = new ArtNode4(); break;
+        case ART16:  n = new ArtNode16(); break;
+        case ART48:  n = new ArtNode48(); break;
+        default:     n = new ArtNode256(); break;
+    }
+    n->type = type;
+    n->count = 0;
+    n->value = nullptr;
+    return n;                          // value-initialised: keys/children zeroed
+}
+
+// Function to free one inner node (not its children)
+void artFreeNode(ArtNode* n) {
+    switch (n->type) {
+        case ART4:   delete (ArtNode4*)n; break;
+        case ART16:  delete (ArtNode16*)n; break;
+        case ART48:  delete (ArtNode48*)n; break;
+        default:     delete (ArtNode256*)n; break;
+    }
+}
+
+// Function to find the child slot for byte c (nullptr if absent)
+ArtNode** artFindChild(ArtNode* n, unsigned char c) {
+    switch (n->type) {
+        case ART4: {
+            ArtNode4* n4 = (ArtNode4*)n;
+            for (int i = 0; i < n->count; i++)
+                if (n4->keys[i] == c) return &n4->child[i];
+            return nullptr;
+        }
+        case ART16: {
+            ArtNode16* n16 = (ArtNode16*)n;
+            for (int i = 0; i < n->count; i++)
+                if (n16->keys[i] == c) return &n16->child[i];
+            return nullptr;
+        }
+        case ART48: {
+            ArtNode48* n48 = (ArtNode48*)n;
+            return n48->index[c] ? &n48->child[n48->index[c] - 1] : nullptr;
+        }
+        default: {
+            ArtNode256* n256 = (ArtNode256*)n;
+            return n256->child[c] ? &n256->child[c] : nullptr;
+        }
+    }
+}
+
+// Function to list the children of n in increasing byte order; returns count
+int artChildren(ArtNode* n, unsigned char* bytes, ArtNode** children) {
+    int k = 0;
+    switch (n->type) {
+        case ART4:
+            for (int i = 0; i < n->count; i++) {
+                bytes[k] = ((ArtNode4*)n)->keys[i];
+                children[k++] = ((ArtNode4*)n)->child[i];
+            }
+            break;
+        case ART16:
+            for (int i = 0; i < n->count; i++) {
+                bytes[k] = ((ArtNode16*)n)->keys[i];
+                children[k++] = ((ArtNode16*)n)->child[i];
+            }
+            break;
+        case ART48:
+            for (int b = 0; b < 256; b++) {
+                if (((ArtNode48*)n)->index[b] == 0) continue;
+                bytes[k] = b;
+                children[k++] = ((ArtNode48*)n)->child[((ArtNode48*)n)->index[b] - 1];
+            }
+            break;
+        default:
+            for (int b = 0; b < 256; b++) {
+                if (((ArtNode256*)n)->child[b] == nullptr) continue;
+                bytes[k] = b;
+                children[k++] = ((ArtNode256*)n)->child[b];
+            }
+            break;
+    }
+    return k;
+}
+
+// Function to rebuild node n with a different size class holding the same
+// prefix, value and children; frees n and returns the new node
+ArtNode* artResize(ArtNode* n, ArtType type) {
+    unsigned char bytes[256];
+    ArtNode* children[256];
+    int k = artChildren(n, bytes, children);
+    ArtNode* m = artNewNode(type);
+    m->prefix = move(n->prefix);
+    m->value = n->value;
+    m->count = k;
+    for (int i = 0; i < k; i++) {
+        switch (type) {
+            case ART4:   ((ArtNode4*)m)->keys[i] = bytes[i]; ((ArtNode4*)m)->child[i] = children[i]; break;
+            case ART16:  ((ArtNode16*)m)->keys[i] = bytes[i]; ((ArtNode16*)m)->child[i] = children[i]; break;
+            case ART48:  ((ArtNode48*)m)->index[bytes[i]] = i + 1; ((ArtNode48*)m)->child[i] = children[i]; break;
+            default:     ((ArtNode256*)m)->child[bytes[i]] = children[i]; break;
+        }
+    }
+    artFreeNode(n);
+    return m;
+}
+
+// Insert (byte, child) into a sorted key/child array of a Node4 or Node16
+void artInsertSorted(unsigned char* keys, ArtNode** child, int count, unsigned char c, ArtNode* node) {
+    int i = count;
+    while (i > 0 && keys[i - 1] > c) {
+        keys[i] = keys[i - 1];
+        child[i] = child[i - 1];
+        i--;
+    }
+    keys[i] = c;
+    child[i] = node;
+}
+
+// Function to add a child under byte c, growing the node when it is full
+void artAddChild(ArtNode*& ref, unsigned char c, ArtNode* child) {
+    ArtNode* n = ref;
+    switch (n->type) {
+        case ART4:
+            if (n->count == 4) break;
+            artInsertSorted(((ArtNode4*)n)->keys, ((ArtNode4*)n)->child, n->count++, c, child);
+            return;
+        case ART16:
+            if (n->count == 16) break;
+            artInsertSorted(((ArtNode16*)n)->keys, ((ArtNode16*)n)->child, n->count++, c, child);
+            return;
+        case ART48:
+            if (n->count == 48) break;
+            ((ArtNode48*)n)->child[n->count] = child;   // Slots are kept dense
+            ((ArtNode48*)n)->index[c] = ++n->count;
+            return;
+        default:
+            ((ArtNode256*)n)->child[c] = child;
+            n->count++;
+            return;
+    }
+    ref = artResize(n, (ArtType)(n->type + 1));          // Full: grow to next size
+    artAddChild(ref, c, child);
+}
+
+// Function to remove the child under byte c, shrinking the node when sparse
+void artRemoveChild(ArtNode*& ref, unsigned char c) {
+    ArtNode* n = ref;
+    switch (n->type) {
+        case ART4:
+        case ART16: {
+            unsigned char* keys = (n->type == ART4) ? ((ArtNode4*)n)->keys : ((ArtNode16*)n)->keys;
+            ArtNode** child = (n->type == ART4) ? ((ArtNode4*)n)->child : ((ArtNode16*)n)->child;
+            int i = 0;
+            while (keys[i] != c) i++;
+            for (; i + 1 < n->count; i++) {
+                keys[i] = keys[i + 1];
+                child[i] = child[i + 1];
+            }
+            n->count--;
+            if (n->type == ART16 && n->count <= 3) ref = artResize(n, ART4);
+            return;
+        }
+        case ART48: {
+            ArtNode48* n48 = (ArtNode48*)n;
+            int slot = n48->index[c] - 1, last = n->count - 1;
+            n48->index[c] = 0;
+            if (slot != last) {                          // Move last slot into the hole
+                n48->child[slot] = n48->child[last];
+                for (int b = 0; b < 256; b++)
+                    if (n48->index[b] == last + 1) { n48->index[b] = slot + 1; break; }
+            }
+            n48->child[last] = nullptr;
+            n->count--;
+            if (n->count <= 12) ref = artResize(n, ART16);
+            return;
+        }
+        default:
+            ((ArtNode256*)n)->child[c] = nullptr;
+            n->count--;
+            if (n->count <= 40) ref = artResize(n, ART48);
+            return;
+    }
+}
+
+// Function to put a leaf below an inner node at the given key depth
+void artPlace(ArtNode*& ref, ArtLeaf* leaf, size_t depth) {
+    if (leaf->key.size() == depth) ref->value = leaf;    // Key ends at this node
+    else artAddChild(ref, leaf->key[depth], artTagLeaf(leaf));
+}
+
+// Function to insert a keyword; returns false for duplicates
+bool artInsert(ArtNode*& ref, const string& key, const string& meaning, size_t depth) {
+    if (ref == nullptr) {
+        ref = artTagLeaf(new ArtLeaf{key, meaning});
+        return true;
+    }
+    if (artIsLeaf(ref)) {                                // Replace leaf by a node holding both keys
+        ArtLeaf* old = artAsLeaf(ref);
+        if (old->key == key) return false;
+        size_t p = depth;
+        while (p < old->key.size() && p < key.size() && old->key[p] == key[p]) p++;
+        ArtNode* n = artNewNode(ART4);
+        n->prefix = key.substr(depth, p - depth);
+        artPlace(n, old, p);
+        artPlace(n, new ArtLeaf{key, meaning}, p);
+        ref = n;
+        return true;
+    }
+
+    ArtNode* n = ref;
+    size_t p = 0;
+    while (p < n->prefix.size() && depth + p < key.size() && n->prefix[p] == key[depth + p]) p++;
+    if (p < n->prefix.size()) {                          // Key leaves the compressed path: split it
+        ArtNode* parent = artNewNode(ART4);
+        parent->prefix = n->prefix.substr(0, p);
+        unsigned char c = n->prefix[p];
+        n->prefix.erase(0, p + 1);
+        artAddChild(parent, c, n);
+        artPlace(parent, new ArtLeaf{key, meaning}, depth + p);
+        ref = parent;
+        return true;
+    }
+
+    depth += n->prefix.size();
+    if (depth == key.size()) {
+        if (n->value != nullptr) return false;
+        n->value = new ArtLeaf{key, meaning};
+        return true;
+    }
+    ArtNode** child = artFindChild(n, key[depth]);
+    if (child != nullptr) return artInsert(*child, key, meaning, depth + 1);
+    artAddChild(ref, key[depth], artTagLeaf(new ArtLeaf{key, meaning}));
+    return true;
+}
+
+// Function to locate a keyword (one comparison counted per visited node)
+ArtLeaf* artFind(ArtNode* n, const string& key, int& comparisons) {
+    size_t depth = 0;
+    while (n != nullptr) {
+        comparisons++;
+        dictStats.comparisons++;
+        if (artIsLeaf(n)) {                              // Single full comparison at the end
+            ArtLeaf* leaf = artAsLeaf(n);
+            return leaf->key == key ? leaf : nullptr;
+        }
+        if (key.compare(depth, n->prefix.size(), n->prefix) != 0) return nullptr;
+        depth += n->prefix.size();
+        if (depth == key.size()) return n->value;
+        ArtNode** child = artFindChild(n, key[depth]);
+        n = child ? *child : nullptr;
+        depth++;
+    }
+    return nullptr;
+}
+
+// After a removal: drop empty nodes and merge a node left with one child
+// into that child, so the path compression invariant holds again
+void artCollapse(ArtNode*& ref) {
+    ArtNode* n = ref;
+    if (n->count == 0) {
+        ref = n->value ? artTagLeaf(n->value) : nullptr;
+        artFreeNode(n);
+    } else if (n->count == 1 && n->value == nullptr) {
+        ArtNode4* n4 = (ArtNode4*)n;                     // Shrinking guarantees a Node4 here
+        ArtNode* child = n4->child[0];
+        if (!artIsLeaf(child)) child->prefix = n->prefix + (char)n4->keys[0] + child->prefix;
+        ref = child;
+        artFreeNode(n);
+    }
+}
+
+// Function to delete a keyword; returns false if it was not present
+bool artRemove(ArtNode*& ref, const string& key, size_t depth) {
+    if (ref == nullptr) return false;
+    if (artIsLeaf(ref)) {
+        ArtLeaf* leaf = artAsLeaf(ref);
+        if (leaf->key != key) return false;
+        delete leaf;
+        ref = nullptr;
+        return true;
+    }
+    ArtNode* n = ref;
+    if (key.compare(depth, n->prefix.size(), n->prefix) != 0) return false;
+    depth += n->prefix.size();
+    if (depth == key.size()) {
+        if (n->value == nullptr) return false;
+        delete n->value;
+        n->value = nullptr;
+    } else {
+        unsigned char c = key[depth];
+        ArtNode** child = artFindChild(n, c);
+        if (child == nullptr || !artRemove(*child, key, depth + 1)) return false;
+        if (*child == nullptr) artRemoveChild(ref, c);
+    }
+    artCollapse(ref);
+    return true;
+}
+
+// Function to visit leaves in ascending (or descending) key order; the
+// visitor returns false to stop early. Returns false if stopped.
+template <class Visit>
+bool artWalk(ArtNode* n, bool descending, Visit& visit) {
+    if (n == nullptr) return true;
+    if (artIsLeaf(n)) return visit(artAsLeaf(n));
+    unsigned char bytes[256];
+    ArtNode* children[256];
+    int k = artChildren(n, bytes, children);
+    if (!descending && n->value && !visit(n->value)) return false; // Shorter key sorts first
+    for (int i = 0; i < k; i++) {
+        if (!artWalk(children[descending ? k - 1 - i : i], descending, visit)) return false;
+    }
+    if (descending && n->value && !visit(n->value)) return false;
+    return true;
+}
+
+// Function to collect up to `limit` keywords starting with prefix, in order
+vector<ArtLeaf*> prefixScan(ArtNode* root, const string& prefix, size_t limit) {
+    vector<ArtLeaf*> result;
+    ArtNode* n = root;
+    size_t depth = 0;
+    while (n != nullptr && !artIsLeaf(n)) {              // Find the subtree covering prefix
+        size_t rest = prefix.size() - depth;
+        size_t m = min(rest, n->prefix.size());
+        if (prefix.compare(depth, m, n->prefix, 0, m) != 0) return result;
+        if (rest <= n->prefix.size()) break;             // Prefix ends inside this path
+        depth += n->prefix.size();
+        ArtNode** child = artFindChild(n, prefix[depth]);
+        n = child ? *child : nullptr;
+        depth++;
+    }
+    auto visit = [&](ArtLeaf* leaf) {
+        if (result.size() >= limit) return false;        // limit == 0: nothing to collect
+        if (leaf->key.compare(0, prefix.size(), prefix) == 0) result.push_back(leaf);
+        return result.size() < limit;
+    };
+    artWalk(n, false, visit);
+    return result;
+}
+
+// Function to compute the height of the radix tree (leaves count as a level)
+int artHeight(ArtNode* n) {
+    if (n == nullptr) return 0;
+    if (artIsLeaf(n)) return 1;
+    unsigned char bytes[256];
+    ArtNode* children[256];
+    int k = artChildren(n, bytes, children), best = 0;
+    for (int i = 0; i < k; i++) best = max(best, artHeight(children[i]));
+    return best + 1;
+}
+
+// Function to count bytes used by the radix tree (nodes, leaves and strings)
+size_t artMemory(ArtNode* n) {
+    if (n == nullptr) return 0;
+    if (artIsLeaf(n)) {
+        ArtLeaf* leaf = artAsLeaf(n);
+        return sizeof(ArtLeaf) + stringHeapBytes(leaf->key) + stringHeapBytes(leaf->meaning);
+    }
+    const size_t sizes[4] = {sizeof(ArtNode4), sizeof(ArtNode16), sizeof(ArtNode48), sizeof(ArtNode256)};
+    size_t bytes = sizes[n->type] + stringHeapBytes(n->prefix);
+    if (n->value) bytes += artMemory(artTagLeaf(n->value));
+    unsigned char keys[256];
+    ArtNode* children[256];
+    int k = artChildren(n, keys, children);
+    for (int i = 0; i < k; i++) bytes += artMemory(children[i]);
+    return bytes;
+}
+
+// Function to search a keyword in the radix tree and count comparisons
+int artSearch(ArtNode* root, string key, int& comparisons) {
+    OpTimer timer(dictStats);
+    ArtLeaf* found = artFind(root, key, comparisons);
+    timer.finish(OP_SEARCH, [&] { return artHeight(root); });
+    if (found != nullptr) {
+        cout << "Found: " << found->meaning << endl;
+    } else {
+        cout << "Keyword not found.\n";
+    }
+    return comparisons;
+}
+
+// Function to update the meaning of a keyword in the radix tree
+void artUpdate(ArtNode* root, string key) {
+    int comparisons = 0;
+    ArtLeaf* found = artFind(root, key, comparisons);
+    if (found == nullptr) {
+        cout << "Keyword not found.\n";
+        return;
+    }
+    cout << "Enter new meaning: ";
+    getline(cin, found->meaning);
+    cout << "Updated successfully.\n";
+}
+
+// Function to print the radix tree in ascending or descending order
+void artDisplay(ArtNode* root, bool descending) {
+    auto print = [](ArtLeaf* leaf) {
+        cout << leaf->key << ": " << leaf->meaning << endl;
+        return true;
+    };
+    artWalk(root, descending, print);
+}
+
+// Function to free the whole radix tree
+void artDestroy(ArtNode* n) {
+    if (n == nullptr) return;
+    if (artIsLeaf(n)) {
+        delete artAsLeaf(n);
+        return;
+    }
+    unsigned char bytes[256];
+    ArtNode* children[256];
+    int k = artChildren(n, bytes, children);
+    for (int i = 0; i < k; i++) artDestroy(children[i]);
+    delete n->value;
+    artFreeNode(n);
+}
+
+// Benchmark: build BST, B-Tree, splay tree and radix tree on the same n
+// keywords, report memory per key, then time n uniform and n Zipfian lookups
+// on each. The AVL dictionary runs the same workloads (from
+// dictionary_stats.h), so its numbers are directly comparable.
+void benchmark(int n, bool terms) {
+    typedef chrono::steady_clock clock;
+    auto ms = [](clock::duration d) { return chrono::duration<double, milli>(d).count(); };
+    uint64_t savedRotations = dictStats.rotations;   // Keep benchmark out of the statistics
+    vector<string> keys(n);
+    for (int i = 0; i < n; i++) keys[i] = terms ? benchmarkTerm(i) : benchmarkKey(i);
+
+    Node* bst = nullptr;
+    BTreeNode* bt = nullptr;
+    Node* splayRoot = nullptr;
+    ArtNode* art = nullptr;
+    double insertMs[4];
+
+    auto s = clock::now();
+    for (int i = 0; i < n; i++) bst = insert(bst, createNode(keys[i], "m"));
+    insertMs[0] = ms(clock::now() - s);
+    s = clock::now();
+    for (int i = 0; i < n; i++) bt = btInsert(bt, keys[i], "m");
+    insertMs[1] = ms(clock::now() - s);
+    s = clock::now();
+    for (int i = 0; i < n; i++) splayRoot = splayInsert(splayRoot, createNode(keys[i], "m"));
+    insertMs[2] = ms(clock::now() - s);
+    s = clock::now();
+    for (int i = 0; i < n; i++) artInsert(art, keys[i], "m", 0);
+    insertMs[3] = ms(clock::now() - s);
+
+    const char* names[4] = {"BST   ", "B-Tree", "Splay ", "Radix "};
+    size_t memory[4] = {bstMemory(bst), btMemory(bt), bstMemory(splayRoot), artMemory(art)};
+    cout << "Keys: " << n << (terms ? " prefix-sharing terms\n" : " random words\n");
+    for (int i = 0; i < 4; i++) {
+        cout << "  " << names[i] << ": insert " << insertMs[i] << " ms, "
+             << (double)memory[i] / n << " bytes/key\n";
+    }
+
+    for (int w = 0; w < 2; w++) {
+        vector<int> lookups = benchmarkLookups(n, n, w == 1);
+        long long comps[4] = {0, 0, 0, 0};
+        double time[4];
+        long long found = 0;
+
+        // Time one structure over the whole lookup sequence
+        auto run = [&](int which, auto find) {
+            auto start = clock::now();
+            for (int k : lookups) {
+                int c = 0;
+                found += find(keys[k], c);
+                comps[which] += c;
+            }
+            time[which] = ms(clock::now() - start);
+        };
+        run(0, [&](const string& key, int& c) { return findNode(bst, key, c) != nullptr; });
+        run(1, [&](const string& key, int& c) { int idx; return btFind(bt, key, idx, c) != nullptr; });
+        run(2, [&](const string& key, int& c) { return splayFind(splayRoot, key, c) != nullptr; });
+        run(3, [&](const string& key, int& c) { return artFind(art, key, c) != nullptr; });
+
+        cout << (w == 0 ? "Uniform" : "Zipfian (s = 1)") << " lookups (found "
+             << found << " of " << 4LL * n << "):\n";
+        for (int i = 0; i < 4; i++) {
+            cout << "  " << names[i] << ": " << time[i] * 1e6 / n << " ns/lookup, "
+                 << (double)comps[i] / n << " comparisons/lookup\n";
+        }
+    }
+
+    destroyTree(bst);
+    btDestroy(bt);
+    destroyTree(splayRoot);
+    artDestroy(art);
+    dictStats.rotations = savedRotations;
+    dictStats.comparisons = 0;
+}
+
 int main() {
     Node* root = nullptr;
-    int choice;
+    BTreeNode* btRoot = nullptr;       // Root of the B-Tree (used when mode == 2)
+    ArtNode* artRoot = nullptr;        // Root of the radix tree (used when mode == 4)
+    int choice, mode;
     string key, meaning;
 
+    const char* modeNames[5] = {"", "BST", "B-Tree", "Splay", "Radix"};
+
+    cout << "Select dictionary structure:\n1. Binary Search Tree\n2. B-Tree\n3. Splay Tree\n4. Radix Tree\nEnter choice: ";
+    cin >> mode;
+    if (mode < 1 || mode > 4) mode = 1; // Default to the BST
+    dictStats.structure = modeNames[mode];
+    // The splay tree shares Node with the BST and lives in `root` as well
+    auto height = [&] {
+        return (mode == 2) ? btHeight(btRoot) : (mode == 4) ? artHeight(artRoot) : treeHeight(root);
+    };
+
     do {
-        cout << "\nDictionary Menu:\n";
-        cout << "1. Add Keyword\n2. Delete Keyword\n3. Update Meaning\n4. Display Ascending\n5. Display Descending\n6. Search Keyword\n7. Exit\nEnter choice: ";
+        cout << "\nDictionary Menu (" << modeNames[mode] << "):\n";
+        cout << "1. Add Keyword\n2. Delete Keyword\n3. Update Meaning\n4. Display Ascending\n5. Display Descending\n6. Search Keyword\n7. Benchmark BST / B-Tree / Splay / Radix\n8. Show/Export Statistics (JSON)\n9. Save Dictionary\n10. Load Dictionary\n11. Prefix Scan\n12. Exit\nEnter choice: ";
         cin >> choice;
         cin.ignore(); // To clear newline after integer input
 
@@ -137,43 +1325,138 @@ int main() {
                 getline(cin, key);
                 cout << "Enter meaning (Value): ";
                 getline(cin, meaning);
-                root = insert(root, createNode(key, meaning));
+                {
+                    OpTimer timer(dictStats);
+                    if (mode == 1) root = insert(root, createNode(key, meaning));
+                    else if (mode == 2) btRoot = btInsert(btRoot, key, meaning);
+                    else if (mode == 3) root = splayInsert(root, createNode(key, meaning));
+                    else if (!artInsert(artRoot, key, meaning, 0)) cout << "Duplicate key. Not inserting.\n";
+                    timer.finish(OP_INSERT, height);
+                }
                 break;
             case 2:
                 cout << "Enter keyword to delete: ";
                 getline(cin, key);
-                root = deleteNode(root, key);
+                {
+                    OpTimer timer(dictStats);
+                    if (mode == 1) root = deleteNode(root, key);
+                    else if (mode == 2) btRoot = btDeleteNode(btRoot, key);
+                    else if (mode == 3) root = splayDelete(root, key);
+                    else if (!artRemove(artRoot, key, 0)) cout << "Keyword not found.\n";
+                    timer.finish(OP_DELETE, height);
+                }
                 break;
             case 3:
                 cout << "Enter keyword to update: ";
                 getline(cin, key);
-                update(root, key);
+                if (mode == 1) update(root, key);
+                else if (mode == 2) btUpdate(btRoot, key);
+                else if (mode == 3) splayUpdate(root, key);
+                else artUpdate(artRoot, key);
                 break;
             case 4:
                 cout << "Dictionary in Ascending Order:\n";
-                inorder(root);
+                if (mode == 2) btInorder(btRoot);
+                else if (mode == 4) artDisplay(artRoot, false);
+                else inorder(root);
                 break;
             case 5:
                 cout << "Dictionary in Descending Order:\n";
-                reverseInorder(root);
+                if (mode == 2) btReverseInorder(btRoot);
+                else if (mode == 4) artDisplay(artRoot, true);
+                else reverseInorder(root);
                 break;
             case 6:
                 cout << "Enter keyword to search: ";
                 getline(cin, key);
                 {
                     int comps = 0;
-                    int total = search(root, key, comps);
+                    int total = (mode == 1) ? search(root, key, comps)
+                              : (mode == 2) ? btSearch(btRoot, key, comps)
+                              : (mode == 3) ? splaySearch(root, key, comps)
+                                            : artSearch(artRoot, key, comps);
                     cout << "Comparisons made: " << total << endl;
                 }
                 break;
             case 7:
+                cout << "Enter number of keys to benchmark (e.g. 10000000): ";
+                {
+                    int n, style;
+                    cin >> n;
+                    cout << "Key style (1 = random words, 2 = prefix-sharing terms): ";
+                    cin >> style;
+                    cin.ignore();
+                    if (n > 0) benchmark(n, style == 2);
+                }
+                break;
+            case 8:
+                cout << "Enter file name for JSON export (leave empty to print): ";
+                getline(cin, key);
+                if (key.empty()) {
+                    cout << dictStats.toJson();
+                } else if (dictStats.exportJson(key)) {
+                    cout << "Statistics written to " << key << endl;
+                } else {
+                    cout << "Could not write " << key << endl;
+                }
+                break;
+            case 9:
+                if (mode == 2 || mode == 4) {
+                    cout << "Snapshots are available in BST and Splay modes.\n";
+                    break;
+                }
+                cout << "Enter snapshot file name: ";
+                getline(cin, key);
+                if (save(root, key)) cout << "Dictionary saved to " << key << endl;
+                else cout << "Could not write " << key << endl;
+                break;
+            case 10:
+                if (mode == 2 || mode == 4) {
+                    cout << "Snapshots are available in BST and Splay modes.\n";
+                    break;
+                }
+                cout << "Enter snapshot file name: ";
+                getline(cin, key);
+                {
+                    uint64_t count = 0;
+                    auto start = chrono::steady_clock::now();
+                    if (load(key, root, count)) {
+                        cout << "Loaded " << count << " keywords in "
+                             << chrono::duration<double, milli>(chrono::steady_clock::now() - start).count()
+                             << " ms.\n";
+                    } else {
+                        cout << "Could not load " << key << " (missing or corrupt snapshot).\n";
+                    }
+                }
+                break;
+            case 11:
+                if (mode != 4) {
+                    cout << "Prefix scan is available in Radix mode.\n";
+                    break;
+                }
+                cout << "Enter prefix: ";
+                getline(cin, key);
+                {
+                    size_t limit;
+                    cout << "Maximum number of results: ";
+                    cin >> limit;
+                    cin.ignore();
+                    vector<ArtLeaf*> matches = prefixScan(artRoot, key, limit);
+                    for (ArtLeaf* leaf : matches) cout << leaf->key << ": " << leaf->meaning << endl;
+                    cout << matches.size() << " keyword(s) found.\n";
+                }
+                break;
+            case 12:
                 cout << "Exiting...\n";
                 break;
             default:
                 cout << "Invalid choice!\n";
         }
-    } while (choice != 7);
+    } while (choice != 12);
 
+    destroyTree(root);
+    btDestroy(btRoot);
+    artDestroy(artRoot);
     return 0;
 }
 
@@ -197,7 +1480,65 @@ Note: Worst case becomes O(n) when BST is unbalanced (linear chain of nodes)
 - Traversals help in sorting data (inorder for ascending, reverse inorder for descending).
 - Comparison counting in search simulates worst-case time complexity analysis.
 
-/*
+B-TREE MODE (alternative structure, chosen at startup):
+-----------------------------------------------------------------------------------------
+- Minimum degree t = 8: every node except the root holds 7..15 keys, so the
+  height is about log_8(n) (~8 levels for 10M keys vs ~50 for a random BST).
+- Each node stores its keys inline plus an 8-byte big-endian prefix per key;
+  comparing two prefixes as integers gives the same order as comparing the
+  strings, so most comparisons never touch the string data.
+- Insert splits full nodes on the way down; delete borrows from / merges with
+  siblings on the way down, so both finish in a single root-to-leaf pass.
+- Search/Insert/Delete/Update: O(t * log_t n) comparisons, O(log_t n) cache misses.
+- Menu option 7 builds both structures on n generated keys and reports insert
+  time, ns per lookup and comparisons per lookup.
+
+SPLAY TREE MODE:
+-----------------------------------------------------------------------------------------
+- Same nodes as the BST, but search/insert/delete/update first splay the key
+  to the root using top-down splaying (zig, zig-zig, zig-zag in one pass
+  down the tree, no parent pointers or recursion).
+- Amortized O(log n) per operation; keys accessed often stay near the root,
+  so for skewed (Zipfian) lookups the average cost approaches the entropy
+  of the access distribution instead of log n.
+- Insert/delete are done by splaying and then splitting/joining at the root.
+- Menu option 7 reports ns and comparisons per lookup for BST, B-Tree and
+  splay tree under uniform and Zipfian lookups; the AVL dictionary's
+  benchmark option runs the identical workloads for comparison.
+
+RADIX TREE MODE (Adaptive Radix Tree):
+-----------------------------------------------------------------------------------------
+- Keys are followed one byte per level; a run of bytes shared by every key
+  below a node is stored once in that node (path compression), and a key
+  whose remaining bytes are unique hangs as a leaf right away.
+- Inner nodes adapt to their number of children: Node4 and Node16 (sorted
+  byte arrays), Node48 (256-entry byte index into 48 slots) and Node256
+  (direct array). Nodes grow when full and shrink when sparse.
+- Search/Insert/Delete: O(key length), with only one full key comparison
+  (at the leaf), independent of the number of keys.
+- prefixScan(prefix, limit): walk down to the subtree covering the prefix,
+  then list up to `limit` keys in order (menu option 11).
+- The benchmark (option 7) also reports bytes per key for every structure,
+  with random words or long prefix-sharing technical terms as keys.
+
+SNAPSHOTS (menu options 9 and 10):
+-----------------------------------------------------------------------------------------
+- save() writes the tree in pre-order: per node a flags byte (has left /
+  has right child) and the key and meaning as length-prefixed strings.
+  No pointers are stored.
+- load() reads the whole file in one sequential read and rebuilds the exact
+  same shape from the flags, using an explicit stack of nodes whose right
+  subtree is pending: O(n) time, zero key comparisons, no recursion.
+- A truncated or corrupt file is rejected and the current tree is kept.
+
+INSTRUMENTATION (dictionary_stats.h, shared with the AVL dictionary):
+-----------------------------------------------------------------------------------------
+- Every insert/search/delete records its key comparisons and its latency in
+  a power-of-two nanosecond histogram.
+- The tree height is sampled over time; the sampling rate halves whenever
+  1024 samples have been stored, so memory stays bounded.
+- Menu option 8 prints the statistics as JSON or writes them to a file.
+
 - This program implements a dictionary using Binary Search Tree (BST).
 - Each node contains:
   -> key (string) = keyword
@@ -240,5 +1581,3 @@ Note: Worst case becomes O(n) when BST is unbalanced (linear chain of nodes)
 - Space complexity for whole tree: O(n) for storing n nodes
 - Extra space used in recursion: O(h) where h is tree height
 */
-
-*/
@@ -2,6 +2,22 @@
 #include <vector>// vector: for dynamic arrays like cities, visited, and adjacency lists
 #include <string> // string: to handle city names and other text data
 #include <unordered_map>// unordered_map: for representing the adjacency list (maps city index to a list of flights)
+#include <chrono> // chrono: for timing the traversal benchmark
+#include <random> // random: for generating benchmark networks
+#include <limits> // numeric_limits: "no route" cost
+#include <cmath> // sqrt, ceil, floor: geometric benchmark network and A* heuristic
+#include <algorithm> // reverse: building route paths
+#include <fstream> // fstream: saving and loading contraction hierarchies
+#include <cstdint> // fixed width integers in the file format
+#include <atomic> // atomic: lock-free union-find shared between threads
+#include <thread> // thread: parallel connected components and BFS
+#include <memory> // unique_ptr: array of atomics; shared_ptr: mapped snapshot files
+#include <cstring> // memcpy: snapshot header
+#include <cstdio> // remove: benchmark files
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h> // AVX2 intrinsics for the all-pairs min-plus kernel
+#define HAVE_AVX2_KERNELS 1
+#endif
 
 
 using namespace std;
@@ -12,42 +28,1685 @@ struct Edge {
     int cost;         // Cost of the flight (time or fuel)
 };
 
+// Read-only array that either owns its elements or views memory owned by
+// someone else (a mapped snapshot file). Reads go through one pointer in
+// both cases; writes are only possible after assign/resize.
+template <class T>
+struct FlatArray {
+    vector<T> owned;             // Elements, when the array owns them
+    const T* items = nullptr;    // Where the elements are (owned or viewed)
+    size_t count = 0;
+
+    FlatArray() = default;
+    FlatArray(const FlatArray& other) { *this = other; }
+    FlatArray(FlatArray&&) = default;
+    FlatArray& operator=(FlatArray&&) = default;
+    FlatArray& operator=(const FlatArray& other) {
+        owned = other.owned;
+        count = other.count;
+        items = (other.items == other.owned.data()) ? owned.data() : other.items;
+        return *this;
+    }
+
+    void assign(size_t n, const T& value) { owned.assign(n, value); items = owned.data(); count = n; }
+    void resize(size_t n) { owned.resize(n); items = owned.data(); count = n; }
+    void view(const T* data, size_t n) { owned = vector<T>(); items = data; count = n; }
+    T* writable() { return owned.data(); }
+    const T& operator[](size_t i) const { return items[i]; }
+    const T* data() const { return items; }
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+};
+
+// Compressed sparse row (CSR) form of the flight network: the flights of
+// every city stored back to back in flat arrays, so a traversal reads
+// contiguous memory instead of doing a hash lookup per city
+struct CsrGraph {
+    FlatArray<size_t> offsets;      // Flights of city c are at [offsets[c], offsets[c + 1])
+    FlatArray<int> destinations;    // Destination city of each flight
+    FlatArray<int> costs;           // Cost of each flight
+
+    int numCities() const {
+        return offsets.empty() ? 0 : offsets.size() - 1;
+    }
+};
+
+const long long NO_ROUTE = numeric_limits<long long>::max();  // Cost of an unreachable city
+
+// Cheapest route between two cities
+struct Route {
+    long long cost = NO_ROUTE;   // Total cost, NO_ROUTE if the destination cannot be reached
+    vector<int> path;            // Cities from source to destination (empty if no route)
+    int settled = 0;             // Cities finalized by the search (the work it did)
+};
+
+// Min-heap of (cost, city) pairs where each node has D children. Compared
+// with a binary heap it is shallower (log_D n levels) and the D children
+// that are compared at each level sit next to each other in memory.
+template <int D>
+struct DaryHeap {
+    vector<pair<long long, int>> items;
+
+    bool empty() const { return items.empty(); }
+    const pair<long long, int>& top() const { return items[0]; }
+    void clear() { items.clear(); }
+
+    void push(long long key, int city) {
+        size_t i = items.size();
+        items.push_back(make_pair(key, city));
+        while (i > 0) {                                // Sift up
+            size_t parent = (i - 1) / D;
+            if (items[parent].first <= key) break;
+            items[i] = items[parent];
+            i = parent;
+        }
+        items[i] = make_pair(key, city);
+    }
+
+    void pop() {
+        pair<long long, int> last = items.back();
+        items.pop_back();
+        if (items.empty()) return;
+        size_t i = 0, n = items.size();
+        while (true) {                                 // Sift down: move the smallest child up
+            size_t first = i * D + 1;
+            if (first >= n) break;
+            size_t best = first;
+            size_t end = first + D < n ? first + D : n;
+            for (size_t c = first + 1; c < end; c++) {
+                if (items[c].first < items[best].first) best = c;
+            }
+            if (items[best].first >= last.first) break;
+            items[i] = items[best];
+            i = best;
+        }
+        items[i] = last;
+    }
+};
+
+// Working arrays of one Dijkstra search. They are sized once per network
+// and reset lazily: only the cities the previous query touched are cleared,
+// so a short query does not pay O(V) to start.
+struct SearchState {
+    vector<long long> dist;      // Best known cost from the search origin
+    vector<int> parent;          // Previous city on that route (-1 at the origin)
+    vector<char> done;           // 1 once the city's cost is final
+    vector<int> touched;         // Cities whose entries must be reset
+    DaryHeap<4> heap;
+
+    void prepare(int numCities) {
+        if ((int)dist.size() != numCities) {
+            dist.assign(numCities, NO_ROUTE);
+            parent.assign(numCities, -1);
+            done.assign(numCities, 0);
+        } else {
+            for (int c : touched) {
+                dist[c] = NO_ROUTE;
+                parent[c] = -1;
+                done[c] = 0;
+            }
+        }
+        touched.clear();
+        heap.clear();
+    }
+
+    // Record a cheaper cost for city
+    void label(int city, long long cost, int from) {
+        if (dist[city] == NO_ROUTE) touched.push_back(city);
+        dist[city] = cost;
+        parent[city] = from;
+    }
+};
+
+// Dijkstra over g from source, stopping when target is finalized (target
+// -1: run to completion); returns the number of cities settled. Cities
+// come off the heap in order of cost plus heuristic; with the zero
+// heuristic this is plain Dijkstra, with a consistent lower bound on the
+// remaining cost it is A*.
+template <class Heuristic>
+int dijkstraSearch(const CsrGraph& g, SearchState& state, int source, int target, Heuristic heuristic) {
+    int settled = 0;
+    state.prepare(g.numCities());
+    state.label(source, 0, -1);
+    state.heap.push(heuristic(source), source);
+    while (!state.heap.empty()) {
+        int city = state.heap.top().second;
+        state.heap.pop();
+        if (state.done[city]) continue;                // Stale entry: a cheaper one was already used
+        state.done[city] = 1;
+        settled++;
+        if (city == target) break;
+        long long base = state.dist[city];
+        for (size_t i = g.offsets[city]; i < g.offsets[city + 1]; i++) {
+            int next = g.destinations[i];
+            long long cost = base + g.costs[i];
+            if (cost < state.dist[next]) {
+                state.label(next, cost, city);
+                state.heap.push(cost + heuristic(next), next);
+            }
+        }
+    }
+    return settled;
+}
+
+// Contraction hierarchy: cities are "contracted" one by one in order of
+// importance; removing a city adds a shortcut flight between two of its
+// neighbors whenever the route through it was the only cheapest one. Every
+// city then keeps only its flights (and shortcuts) to more important
+// cities, and a query searches upward from both ends.
+struct ContractionHierarchy {
+    static const int WITNESS_LIMIT = 500;    // Cities a witness search may settle before giving up
+    static const int ESTIMATE_LIMIT = 50;    // Same, when only estimating a city's importance
+
+    vector<int> rank;            // Contraction order of each city (higher = more important)
+    vector<size_t> offsets;      // Upward flights of city c are at [offsets[c], offsets[c + 1])
+    vector<int> targets;         // Higher-ranked city each upward flight leads to
+    vector<long long> costs;     // Cost of each upward flight (shortcuts add up several flights)
+    size_t shortcuts = 0;        // Shortcut flights added during preprocessing
+    int lastSettled = 0;         // Cities settled by the last query
+    SearchState forward, backward, witness;
+
+    int numCities() const {
+        return rank.size();
+    }
+
+    // Working graph used while contracting: merged parallel flights, no loops
+    typedef vector<vector<pair<int, long long>>> WorkGraph;
+
+    static void addOrLower(WorkGraph& adj, int a, int b, long long cost) {
+        for (auto& e : adj[a]) {
+            if (e.first == b) {
+                if (cost < e.second) e.second = cost;
+                return;
+            }
+        }
+        adj[a].push_back(make_pair(b, cost));
+    }
+
+    // Shortcuts needed to contract v (added to adj if apply is true). For
+    // each neighbor u a local Dijkstra that avoids v looks for a "witness"
+    // route to every other neighbor w no more expensive than u-v-w.
+    int contract(WorkGraph& adj, int v, bool apply) {
+        int needed = 0;
+        const vector<pair<int, long long>>& around = adj[v];
+        vector<pair<pair<int, int>, long long>> added;
+        for (size_t i = 0; i < around.size(); i++) {
+            int u = around[i].first;
+            long long limit = 0;
+            for (size_t j = i + 1; j < around.size(); j++) {
+                limit = max(limit, around[i].second + around[j].second);
+            }
+            if (i + 1 == around.size()) continue;      // No later neighbor to connect u to
+            witness.prepare(adj.size());
+            witness.label(u, 0, -1);
+            witness.heap.push(0, u);
+            int settled = 0, remaining = around.size() - i - 1;  // Neighbors still to reach
+            int maxSettled = apply ? WITNESS_LIMIT : ESTIMATE_LIMIT;
+            while (!witness.heap.empty() && settled < maxSettled && remaining > 0) {
+                long long d = witness.heap.top().first;
+                int city = witness.heap.top().second;
+                witness.heap.pop();
+                if (d > limit) break;
+                if (witness.done[city]) continue;
+                witness.done[city] = 1;
+                settled++;
+                for (size_t j = i + 1; j < around.size(); j++) {
+                    if (around[j].first == city) remaining--;
+                }
+                for (const auto& e : adj[city]) {
+                    if (e.first == v) continue;        // Routes through v do not count
+                    long long cost = d + e.second;
+                    if (cost < witness.dist[e.first]) {
+                        witness.label(e.first, cost, city);
+                        witness.heap.push(cost, e.first);
+                    }
+                }
+            }
+            for (size_t j = i + 1; j < around.size(); j++) {
+                long long via = around[i].second + around[j].second;
+                if (witness.dist[around[j].first] > via) {   // No witness: keep the route as a shortcut
+                    needed++;
+                    if (apply) added.push_back(make_pair(make_pair(u, around[j].first), via));
+                }
+            }
+        }
+        for (const auto& s : added) {
+            addOrLower(adj, s.first.first, s.first.second, s.second);
+            addOrLower(adj, s.first.second, s.first.first, s.second);
+        }
+        return needed;
+    }
+
+    // Method to preprocess a frozen network
+    void build(const CsrGraph& g) {
+        int n = g.numCities();
+        WorkGraph adj(n);
+        vector<int> slot(n, -1);                       // Position of a neighbor in adj[c], for merging
+        for (int c = 0; c < n; c++) {
+            for (size_t i = g.offsets[c]; i < g.offsets[c + 1]; i++) {
+                int d = g.destinations[i];
+                if (d == c) continue;
+                if (slot[d] == -1) {
+                    slot[d] = adj[c].size();
+                    adj[c].push_back(make_pair(d, (long long)g.costs[i]));
+                } else if (g.costs[i] < adj[c][slot[d]].second) {
+                    adj[c][slot[d]].second = g.costs[i];
+                }
+            }
+            for (const auto& e : adj[c]) slot[e.first] = -1;
+        }
+
+        // Importance = 2 x (shortcuts added - flights removed) + neighbors
+        // already contracted + level in the hierarchy so far; the last two
+        // spread the contraction evenly over the network
+        vector<int> contractedNeighbors(n, 0), level(n, 0);
+        auto importance = [&](int v) {
+            return 2 * ((long long)contract(adj, v, false) - (long long)adj[v].size()) +
+                   contractedNeighbors[v] + level[v];
+        };
+        DaryHeap<4> queue;
+        for (int v = 0; v < n; v++) queue.push(importance(v), v);
+
+        rank.assign(n, -1);
+        vector<vector<pair<int, long long>>> up(n);
+        size_t originalEdges = 0;
+        for (int v = 0; v < n; v++) originalEdges += adj[v].size();
+        int next = 0;
+        while (!queue.empty()) {
+            int v = queue.top().second;
+            queue.pop();
+            if (rank[v] != -1) continue;
+            long long priority = importance(v);        // Lazy update: recheck before contracting
+            if (!queue.empty() && priority > queue.top().first) {
+                queue.push(priority, v);
+                continue;
+            }
+            contract(adj, v, true);
+            rank[v] = next++;
+            up[v] = adj[v];                            // Every remaining neighbor ranks higher
+            for (const auto& e : adj[v]) {             // Remove v from the working graph
+                vector<pair<int, long long>>& list = adj[e.first];
+                for (size_t i = 0; i < list.size(); i++) {
+                    if (list[i].first == v) {
+                        list[i] = list.back();
+                        list.pop_back();
+                        break;
+                    }
+                }
+                contractedNeighbors[e.first]++;
+                level[e.first] = max(level[e.first], level[v] + 1);
+            }
+            adj[v].clear();
+        }
+
+        offsets.assign(n + 1, 0);
+        for (int v = 0; v < n; v++) offsets[v + 1] = offsets[v] + up[v].size();
+        targets.resize(offsets[n]);
+        costs.resize(offsets[n]);
+        for (int v = 0; v < n; v++) {
+            for (size_t i = 0; i < up[v].size(); i++) {
+                targets[offsets[v] + i] = up[v][i].first;
+                costs[offsets[v] + i] = up[v][i].second;
+            }
+        }
+        shortcuts = offsets[n] > originalEdges / 2 ? offsets[n] - originalEdges / 2 : 0;
+    }
+
+    // Method to find the cheapest cost between two cities: Dijkstra upward
+    // from both ends; the best meeting city is the most important one on
+    // the cheapest route
+    long long query(int source, int destination) {
+        int n = numCities();
+        forward.prepare(n);
+        backward.prepare(n);
+        forward.label(source, 0, -1);
+        forward.heap.push(0, source);
+        backward.label(destination, 0, -1);
+        backward.heap.push(0, destination);
+        long long best = (source == destination) ? 0 : NO_ROUTE;
+        lastSettled = 0;
+
+        while (!forward.heap.empty() || !backward.heap.empty()) {
+            bool goForward = backward.heap.empty() ||
+                             (!forward.heap.empty() && forward.heap.top().first <= backward.heap.top().first);
+            SearchState& side = goForward ? forward : backward;
+            SearchState& other = goForward ? backward : forward;
+            if (side.heap.top().first >= best) {       // This side cannot improve the answer
+                side.heap.clear();
+                continue;
+            }
+            int city = side.heap.top().second;
+            side.heap.pop();
+            if (side.done[city]) continue;
+            side.done[city] = 1;
+            lastSettled++;
+            long long base = side.dist[city];
+            if (other.dist[city] != NO_ROUTE && base + other.dist[city] < best) {
+                best = base + other.dist[city];
+            }
+            for (size_t i = offsets[city]; i < offsets[city + 1]; i++) {
+                int next = targets[i];
+                long long cost = base + costs[i];
+                if (cost < side.dist[next]) {
+                    side.label(next, cost, city);
+                    side.heap.push(cost, next);
+                }
+            }
+        }
+        return best;
+    }
+
+    // Binary file: "FNCH", version, city count, upward flight count, then
+    // the rank, offsets, targets and costs arrays
+    bool save(const string& path) const {
+        ofstream file(path, ios::binary);
+        if (!file) return false;
+        uint32_t version = 1, n = numCities();
+        uint64_t m = targets.size();
+        file.write("FNCH", 4);
+        file.write((const char*)&version, sizeof(version));
+        file.write((const char*)&n, sizeof(n));
+        file.write((const char*)&m, sizeof(m));
+        file.write((const char*)rank.data(), n * sizeof(int));
+        file.write((const char*)offsets.data(), (n + 1) * sizeof(size_t));
+        file.write((const char*)targets.data(), m * sizeof(int));
+        file.write((const char*)costs.data(), m * sizeof(long long));
+        return (bool)file;
+    }
+
+    bool load(const string& path) {
+        ifstream file(path, ios::binary);
+        char magic[4];
+        uint32_t version, n;
+        uint64_t m;
+        if (!file.read(magic, 4) || string(magic, 4) != "FNCH") return false;
+        if (!file.read((char*)&version, sizeof(version)) || version != 1) return false;
+        if (!file.read((char*)&n, sizeof(n)) || !file.read((char*)&m, sizeof(m))) return false;
+        file.seekg(0, ios::end);                       // Check the size before allocating anything
+        uint64_t expected = 4 + sizeof(version) + sizeof(n) + sizeof(m) + (uint64_t)n * sizeof(int) +
+                            ((uint64_t)n + 1) * sizeof(size_t) + m * (sizeof(int) + sizeof(long long));
+        if ((uint64_t)file.tellg() != expected) return false;
+        file.seekg(4 + sizeof(version) + sizeof(n) + sizeof(m));
+
+        vector<int> newRank(n), newTargets(m);
+        vector<size_t> newOffsets(n + 1);
+        vector<long long> newCosts(m);
+        file.read((char*)newRank.data(), n * sizeof(int));
+        file.read((char*)newOffsets.data(), (n + 1) * sizeof(size_t));
+        file.read((char*)newTargets.data(), m * sizeof(int));
+        file.read((char*)newCosts.data(), m * sizeof(long long));
+        if (!file || newOffsets[0] != 0 || newOffsets[n] != m) return false;
+        for (uint32_t c = 0; c < n; c++) {
+            if (newOffsets[c] > newOffsets[c + 1]) return false;
+        }
+        for (int t : newTargets) {
+            if (t < 0 || t >= (int)n) return false;
+        }
+        rank.swap(newRank);
+        offsets.swap(newOffsets);
+        targets.swap(newTargets);
+        costs.swap(newCosts);
+        shortcuts = 0;                                 // Not recorded in the file
+        return true;
+    }
+};
+
+// Union-find that several threads can update at once without locks.
+// Every set is a tree whose root is its smallest city; a root is only ever
+// linked below a smaller root (with compare-and-swap), so no cycles can
+// form, and a find shortens the path it walks (path halving) the same way.
+struct ConcurrentUnionFind {
+    unique_ptr<atomic<int>[]> parent;
+
+    explicit ConcurrentUnionFind(int n) : parent(new atomic<int>[n]) {
+        for (int i = 0; i < n; i++) parent[i].store(i, memory_order_relaxed);
+    }
+
+    int find(int x) {
+        while (true) {
+            int p = parent[x].load(memory_order_relaxed);
+            if (p == x) return x;
+            int grandparent = parent[p].load(memory_order_relaxed);
+            if (grandparent != p) {                       // Path halving: point x at its grandparent
+                parent[x].compare_exchange_weak(p, grandparent, memory_order_relaxed);
+            }
+            x = grandparent;
+        }
+    }
+
+    void unite(int a, int b) {
+        while (true) {
+            a = find(a);
+            b = find(b);
+            if (a == b) return;
+            if (a < b) swap(a, b);                        // Link the larger root below the smaller
+            int expected = a;
+            if (parent[a].compare_exchange_strong(expected, b, memory_order_relaxed)) return;
+            // Another thread linked a first: retry from the new roots
+        }
+    }
+};
+
+// Run work(0) ... work(threads - 1) at the same time, work(0) on the
+// calling thread, and wait for all of them
+template <class Work>
+void runThreads(int threads, Work work) {
+    vector<thread> pool;
+    for (int t = 1; t < threads; t++) pool.emplace_back(work, t);
+    work(0);
+    for (thread& th : pool) th.join();
+}
+
+// Result of a breadth-first search from one city
+struct BfsResult {
+    vector<int> hops;            // Flights needed to reach each city, -1 if not reached
+    int reached = 0;             // Cities with hops >= 0 (the source included)
+    int levels = 0;              // Frontiers expanded
+    int bottomUpLevels = 0;      // ... of which bottom-up
+    long long edgesChecked = 0;  // Flight entries looked at
+};
+
+// Switch to bottom-up when the frontier's flights exceed 1/BFS_ALPHA of the
+// flights not yet explored, and back to top-down when the frontier holds
+// fewer than 1/BFS_BETA of the cities (the usual Beamer et al. constants)
+const int BFS_ALPHA = 14;
+const int BFS_BETA = 24;
+
+// Level-synchronous BFS from source over the CSR arrays, stopping after
+// maxHops levels (maxHops < 0: no limit). Frontiers and the visited set
+// are bitmaps, one bit per city, and every level is split between threads
+// by 64-city words. Each level runs one of two ways:
+//   top-down:  every frontier city claims its unvisited neighbors
+//              (an atomic OR on the visited word decides the winner);
+//   bottom-up: every unvisited city looks for any neighbor in the
+//              frontier and stops at the first one, which is much cheaper
+//              when the frontier is a large part of the network.
+// With directionOptimizing false every level is top-down.
+BfsResult breadthFirstSearch(const CsrGraph& g, int source, int maxHops, int threads, bool directionOptimizing) {
+    int numCities = g.numCities();
+    size_t words = (numCities + 63) / 64;
+    if (threads < 1) threads = 1;
+    unique_ptr<atomic<uint64_t>[]> visited(new atomic<uint64_t>[words]);
+    unique_ptr<atomic<uint64_t>[]> frontier(new atomic<uint64_t>[words]);
+    unique_ptr<atomic<uint64_t>[]> next(new atomic<uint64_t>[words]);
+    for (size_t w = 0; w < words; w++) {
+        visited[w].store(0, memory_order_relaxed);
+        frontier[w].store(0, memory_order_relaxed);
+    }
+    BfsResult result;
+    result.hops.assign(numCities, -1);
+    result.hops[source] = 0;
+    visited[source / 64].store(1ULL << (source % 64), memory_order_relaxed);
+    frontier[source / 64].store(1ULL << (source % 64), memory_order_relaxed);
+
+    auto degree = [&](int city) { return (long long)(g.offsets[city + 1] - g.offsets[city]); };
+    long long frontierEdges = degree(source);
+    long long unexploredEdges = (long long)g.destinations.size() - frontierEdges;
+    long long frontierSize = 1;
+    bool bottomUp = false;
+    vector<long long> threadEdges(threads), threadChecked(threads), threadSize(threads);
+
+    for (int level = 0; frontierSize > 0 && (maxHops < 0 || level < maxHops); level++) {
+        if (directionOptimizing) {
+            if (!bottomUp && frontierEdges > unexploredEdges / BFS_ALPHA) bottomUp = true;
+            else if (bottomUp && frontierSize < numCities / BFS_BETA) bottomUp = false;
+        }
+        for (size_t w = 0; w < words; w++) next[w].store(0, memory_order_relaxed);
+
+        runThreads(threads, [&](int t) {
+            size_t first = words * t / threads, last = words * (t + 1) / threads;
+            long long edges = 0, checked = 0, size = 0;
+            for (size_t w = first; w < last; w++) {
+                if (!bottomUp) {
+                    for (uint64_t bits = frontier[w].load(memory_order_relaxed); bits; bits &= bits - 1) {
+                        int city = w * 64 + __builtin_ctzll(bits);
+                        for (size_t i = g.offsets[city]; i < g.offsets[city + 1]; i++) {
+                            int d = g.destinations[i];
+                            uint64_t mask = 1ULL << (d % 64);
+                            checked++;
+                            if (visited[d / 64].load(memory_order_relaxed) & mask) continue;
+                            if (visited[d / 64].fetch_or(mask, memory_order_relaxed) & mask) continue;  // Another thread won
+                            result.hops[d] = level + 1;
+                            next[d / 64].fetch_or(mask, memory_order_relaxed);
+                            size++;
+                            edges += degree(d);
+                        }
+                    }
+                } else {
+                    uint64_t unvisited = ~visited[w].load(memory_order_relaxed);
+                    if (w == words - 1 && numCities % 64) unvisited &= (1ULL << (numCities % 64)) - 1;
+                    uint64_t found = 0;
+                    for (; unvisited; unvisited &= unvisited - 1) {
+                        int bit = __builtin_ctzll(unvisited);
+                        int city = w * 64 + bit;
+                        for (size_t i = g.offsets[city]; i < g.offsets[city + 1]; i++) {
+                            int d = g.destinations[i];
+                            checked++;
+                            if (frontier[d / 64].load(memory_order_relaxed) & (1ULL << (d % 64))) {
+                                found |= 1ULL << bit;   // One frontier neighbor is enough
+                                result.hops[city] = level + 1;
+                                size++;
+                                edges += degree(city);
+                                break;
+                            }
+                        }
+                    }
+                    if (found) {                        // Word w belongs to this thread alone
+                        next[w].store(found, memory_order_relaxed);
+                        visited[w].fetch_or(found, memory_order_relaxed);
+                    }
+                }
+            }
+            threadEdges[t] = edges;
+            threadChecked[t] = checked;
+            threadSize[t] = size;
+        });
+
+        frontierEdges = frontierSize = 0;
+        for (int t = 0; t < threads; t++) {
+            frontierEdges += threadEdges[t];
+            frontierSize += threadSize[t];
+            result.edgesChecked += threadChecked[t];
+        }
+        unexploredEdges -= frontierEdges;
+        result.levels++;
+        if (bottomUp) result.bottomUpLevels++;
+        swap(frontier, next);
+    }
+    for (int h : result.hops) if (h >= 0) result.reached++;
+    return result;
+}
+
+// Square matrix of bits, one row per city, rows padded to whole 64-bit
+// words so that row operations work on 64 cities per instruction
+struct BitMatrix {
+    int size = 0;                // Rows (= columns)
+    size_t rowWords = 0;         // 64-bit words per row
+    vector<uint64_t> bits;       // Row i is bits[i * rowWords, (i + 1) * rowWords)
+
+    void reset(int n) {
+        size = n;
+        rowWords = (n + 63) / 64;
+        bits.assign(rowWords * n, 0);
+    }
+    uint64_t* row(int i) { return &bits[i * rowWords]; }
+    const uint64_t* row(int i) const { return &bits[i * rowWords]; }
+    bool test(int i, int j) const { return (row(i)[j / 64] >> (j % 64)) & 1; }
+    void set(int i, int j) { row(i)[j / 64] |= 1ULL << (j % 64); }
+};
+
+// Warshall's algorithm on bit rows: after step k, row i holds everything
+// reachable from i through cities 0..k, so "i reaches k" means OR-ing
+// row k into row i, a whole word (64 cities) at a time
+void warshallClosure(BitMatrix& m) {
+    for (int k = 0; k < m.size; k++) {
+        const uint64_t* rowK = m.row(k);
+        size_t word = k / 64;
+        uint64_t bit = 1ULL << (k % 64);
+        for (int i = 0; i < m.size; i++) {
+            uint64_t* rowI = m.row(i);
+            if (!(rowI[word] & bit)) continue;
+            for (size_t w = 0; w < m.rowWords; w++) rowI[w] |= rowK[w];
+        }
+    }
+}
+
+// How a Graph stores its flights
+enum Storage {
+    ADJ_LIST,      // Map from city to its list of flights: memory grows with the flights
+    ADJ_MATRIX,    // Bit row per city plus an n x n cost matrix: memory grows with cities squared
+    AUTO_STORAGE   // List while sparse, matrix once MATRIX_DENSITY of all city pairs have a flight
+};
+
+// Switch an AUTO_STORAGE graph to the matrix at this fraction of city
+// pairs linked: the matrix then takes at most about twice the memory of
+// the list and neighbor set operations run 64 cities at a time
+const double MATRIX_DENSITY = 0.25;
+
+// All-pairs cheapest costs are kept as 32-bit ints. "No route" is
+// APSP_UNREACHABLE, small enough that adding two of them cannot overflow,
+// so the min-plus kernels need no special cases.
+const int APSP_UNREACHABLE = (1 << 30) - 1;
+const int APSP_TILE = 64;                // Floyd-Warshall tile side: one 64 x 64 tile is 16 KB
+
+// Cheapest cost between every pair of cities. Rows are padded to whole
+// tiles (the padding cities are unreachable), so the tiled Floyd-Warshall
+// never needs a partial tile.
+struct DistanceMatrix {
+    int size = 0;                // Cities
+    int stride = 0;              // Ints per row: size rounded up to APSP_TILE
+    vector<int> cells;           // Cost from a to b at cells[a * stride + b]
+
+    void reset(int n) {
+        size = n;
+        stride = (n + APSP_TILE - 1) / APSP_TILE * APSP_TILE;
+        cells.assign((size_t)stride * stride, APSP_UNREACHABLE);
+        for (int c = 0; c < stride; c++) cells[(size_t)c * stride + c] = 0;
+    }
+    int* row(int a) { return &cells[(size_t)a * stride]; }
+    int at(int a, int b) const { return cells[(size_t)a * stride + b]; }
+};
+
+// How allPairsCosts computes the matrix
+enum AllPairsMethod {
+    APSP_AUTO,              // Whichever should be faster for this network (preferFloydWarshall)
+    APSP_FLOYD_WARSHALL,    // O(V^3), independent of the number of flights
+    APSP_DIJKSTRA           // One Dijkstra per city: O(V * E log V)
+};
+
+// APSP_AUTO compares the work: Floyd-Warshall does V^3 / 8 vector steps,
+// V Dijkstra searches about V (E + V log V) edge and heap steps, each
+// roughly 8 times as costly (measured). Floyd-Warshall wins when
+// V^2 < APSP_DIJKSTRA_WEIGHT * (E + V log V).
+const int APSP_DIJKSTRA_WEIGHT = 64;
+
+bool preferFloydWarshall(long long numCities, long long entries) {
+    double dijkstraWork = entries + numCities * log2(max(numCities, 2LL));
+    return (double)numCities * numCities < APSP_DIJKSTRA_WEIGHT * dijkstraWork;
+}
+
+// Floyd-Warshall step for one tile whose inputs may be the tile itself
+// (the diagonal tile and the tiles in its row and column): for every k in
+// order, c[i][j] = min(c[i][j], a[i][k] + b[k][j])
+void minPlusTileInPlace(int* c, const int* a, const int* b, int stride) {
+    for (int k = 0; k < APSP_TILE; k++) {
+        const int* bk = b + (size_t)k * stride;
+        for (int i = 0; i < APSP_TILE; i++) {
+            int aik = a[(size_t)i * stride + k];
+            int* ci = c + (size_t)i * stride;
+            for (int j = 0; j < APSP_TILE; j++) ci[j] = min(ci[j], aik + bk[j]);
+        }
+    }
+}
+
+// Same for a tile that is neither input (every other tile): the order of
+// k no longer matters, so each row of c is finished before the next
+void minPlusTileScalar(int* c, const int* a, const int* b, int stride) {
+    for (int i = 0; i < APSP_TILE; i++) {
+        int* ci = c + (size_t)i * stride;
+        const int* ai = a + (size_t)i * stride;
+        for (int k = 0; k < APSP_TILE; k++) {
+            int aik = ai[k];
+            const int* bk = b + (size_t)k * stride;
+            for (int j = 0; j < APSP_TILE; j++) ci[j] = min(ci[j], aik + bk[j]);
+        }
+    }
+}
+
+#ifdef HAVE_AVX2_KERNELS
+// AVX2 version: a row of c (64 ints) stays in eight registers while all 64
+// rows of b are added and min-ed into it, eight ints per instruction (the
+// loops over the eight registers must be unrolled, or the row is spilled)
+__attribute__((target("avx2")))
+void minPlusTileAvx2(int* c, const int* a, const int* b, int stride) {
+    const int VECTORS = APSP_TILE / 8;
+    for (int i = 0; i < APSP_TILE; i++) {
+        int* ci = c + (size_t)i * stride;
+        const int* ai = a + (size_t)i * stride;
+        __m256i row[VECTORS];
+#pragma GCC unroll 8
+        for (int v = 0; v < VECTORS; v++) row[v] = _mm256_loadu_si256((const __m256i*)(ci + 8 * v));
+        for (int k = 0; k < APSP_TILE; k++) {
+            __m256i aik = _mm256_set1_epi32(ai[k]);
+            const int* bk = b + (size_t)k * stride;
+#pragma GCC unroll 8
+            for (int v = 0; v < VECTORS; v++) {
+                __m256i through = _mm256_add_epi32(aik, _mm256_loadu_si256((const __m256i*)(bk + 8 * v)));
+                row[v] = _mm256_min_epi32(row[v], through);
+            }
+        }
+#pragma GCC unroll 8
+        for (int v = 0; v < VECTORS; v++) _mm256_storeu_si256((__m256i*)(ci + 8 * v), row[v]);
+    }
+}
+#endif
+
+bool cpuHasAvx2() {
+#ifdef HAVE_AVX2_KERNELS
+    return __builtin_cpu_supports("avx2");
+#else
+    return false;
+#endif
+}
+
+// Blocked Floyd-Warshall: for each diagonal tile kb, (1) run Floyd-Warshall
+// inside it, (2) update the other tiles of its row and column from it,
+// (3) update every remaining tile (i, j) from tiles (i, kb) and (kb, j).
+// Steps 2 and 3 are spread over the threads; step 3 is nearly all the work
+// and each of its tiles works on three 16 KB tiles that stay in cache.
+void floydWarshallTiled(DistanceMatrix& d, int threads, bool allowSimd) {
+    int tiles = d.stride / APSP_TILE;
+    bool avx2 = allowSimd && cpuHasAvx2();
+    auto tile = [&](int ti, int tj) { return &d.cells[(size_t)ti * APSP_TILE * d.stride + (size_t)tj * APSP_TILE]; };
+    for (int kb = 0; kb < tiles; kb++) {
+        int* diagonal = tile(kb, kb);
+        minPlusTileInPlace(diagonal, diagonal, diagonal, d.stride);
+
+        runThreads(threads, [&](int t) {
+            for (int other = t; other < tiles; other += threads) {
+                if (other == kb) continue;
+                int* rowTile = tile(kb, other);
+                int* columnTile = tile(other, kb);
+                minPlusTileInPlace(rowTile, diagonal, rowTile, d.stride);
+                minPlusTileInPlace(columnTile, columnTile, diagonal, d.stride);
+            }
+        });
+
+        runThreads(threads, [&](int t) {
+            for (int ti = t; ti < tiles; ti += threads) {
+                if (ti == kb) continue;
+                const int* left = tile(ti, kb);
+                for (int tj = 0; tj < tiles; tj++) {
+                    if (tj == kb) continue;
+#ifdef HAVE_AVX2_KERNELS
+                    if (avx2) {
+                        minPlusTileAvx2(tile(ti, tj), left, tile(kb, tj), d.stride);
+                        continue;
+                    }
+#endif
+                    minPlusTileScalar(tile(ti, tj), left, tile(kb, tj), d.stride);
+                }
+            }
+        });
+    }
+}
+
+#if defined(__linux__) || defined(__APPLE__)
+#include <sys/mman.h>   // mmap: map snapshot files instead of reading them
+#include <sys/stat.h>   // fstat: file size
+#include <fcntl.h>      // open
+#include <unistd.h>     // close
+#define HAVE_MMAP 1
+#endif
+
+// A whole file in memory, read-only: mapped where the OS supports it (pages
+// are loaded on first touch and shared with the page cache), otherwise
+// read into a buffer
+class MappedFile {
+    const char* bytes = nullptr;
+    size_t length = 0;
+    bool mapped = false;
+    vector<char> buffer;         // Used when the file could not be mapped
+
+public:
+    MappedFile() = default;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    ~MappedFile() {
+#ifdef HAVE_MMAP
+        if (mapped) munmap((void*)bytes, length);
+#endif
+    }
+
+    bool open(const string& path) {
+#ifdef HAVE_MMAP
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        struct stat info;
+        if (fstat(fd, &info) == 0 && info.st_size > 0) {
+            void* start = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (start != MAP_FAILED) {
+                bytes = (const char*)start;
+                length = info.st_size;
+                mapped = true;
+            }
+        }
+        ::close(fd);
+        if (mapped) return true;
+#endif
+        ifstream file(path, ios::binary | ios::ate);
+        if (!file) return false;
+        buffer.resize(file.tellg());
+        file.seekg(0);
+        if (!file.read(buffer.data(), buffer.size())) return false;
+        bytes = buffer.data();
+        length = buffer.size();
+        return true;
+    }
+
+    const char* data() const { return bytes; }
+    size_t size() const { return length; }
+};
+
+// Binary snapshot of a whole network ("FNGR", version 2), laid out so the
+// arrays can be used in place straight from the mapped file:
+//   header
+//   size_t   flight offsets[numCities + 1]   (CSR offsets)
+//   uint64_t name offsets[numCities + 1]     (into the name text)
+//   int32_t  destinations[numEntries]        (plus one 0 if numEntries is odd)
+//   int32_t  costs[numEntries]
+//   char     name text[nameBytes]            (no separators)
+// Every array starts 8-byte aligned; the padding after the destinations
+// keeps the costs aligned too. Integers are in the machine's byte order,
+// as in the contraction hierarchy file.
+struct SnapshotHeader {
+    char magic[4];           // "FNGR"
+    uint32_t version;        // SNAPSHOT_VERSION
+    uint32_t numCities;
+    uint32_t reserved;       // 0; keeps the arrays aligned
+    uint64_t numEntries;     // Flight entries (each flight stored both ways)
+    uint64_t nameBytes;
+};
+const uint32_t SNAPSHOT_VERSION = 2;     // 2: destinations padded to 8 bytes
+const size_t IMPORT_SPARE_CITIES = 1 << 20;  // Flightless cities an edge list may leave between its ids
+static_assert(sizeof(SnapshotHeader) == 32, "snapshot header must have no padding");
+static_assert(sizeof(size_t) == sizeof(uint64_t), "snapshot offsets are 64-bit");
+
 // Graph class to represent the flight network
 class Graph {
 private:
     vector<string> cities;                         // List of city names
     unordered_map<int, vector<Edge>> adjList;      // Adjacency list to represent flights
+    CsrGraph csr;                                  // Immutable copy built by freeze()
+    bool frozen = false;                           // True while csr matches adjList
+    Storage storage;                               // Chosen at construction
+    bool matrixMode = false;                       // True while the flights live in the matrix
+    BitMatrix linked;                              // Matrix mode: bit (a, b) set if a flight a-b exists
+    vector<int> costMatrix;                        // Matrix mode: cheapest a-b cost at a * n + b
+    size_t entries = 0;                            // Flight entries stored (each flight twice)
+    bool csrOnly = false;                          // Loaded network: flights only in csr, not in adjList yet
+    bool componentsStale = false;                  // Union-find not built yet for a loaded network
+    shared_ptr<MappedFile> snapshot;               // File the csr arrays point into, if any
+    SearchState forward, backward;                 // Reused by the shortest path searches
+
+    // Walk the parent links of a search back to its origin
+    static void appendPath(const SearchState& state, int city, vector<int>& path) {
+        for (int c = city; c != -1; c = state.parent[c]) path.push_back(c);
+    }
+
+    // Dijkstra (or A*) from source over the CSR copy, see dijkstraSearch
+    template <class Heuristic>
+    Route search(int source, int target, Heuristic heuristic) {
+        if (!frozen) freeze();
+        Route route;
+        route.settled = dijkstraSearch(csr, forward, source, target, heuristic);
+        if (target >= 0 && forward.dist[target] != NO_ROUTE) {
+            route.cost = forward.dist[target];
+            appendPath(forward, target, route.path);
+            reverse(route.path.begin(), route.path.end());
+        }
+        return route;
+    }
+
+    // Union-find over the cities, updated by every addFlight, so that
+    // connectivity questions never need a traversal
+    vector<int> componentParent;                   // Parent in the union-find forest (root: itself)
+    vector<int> componentSize;                     // Cities in the set (valid at roots)
+    int componentCount = 0;                        // Number of separate groups of cities
+
+    int findComponent(int city) {
+        while (componentParent[city] != city) {
+            componentParent[city] = componentParent[componentParent[city]];  // Path halving
+            city = componentParent[city];
+        }
+        return city;
+    }
+
+    void joinComponents(int a, int b) {
+        int numCities = cities.size();
+        if (a < 0 || b < 0 || a >= numCities || b >= numCities) return;
+        a = findComponent(a);
+        b = findComponent(b);
+        if (a == b) return;
+        if (componentSize[a] < componentSize[b]) swap(a, b);   // Union by size
+        componentParent[b] = a;
+        componentSize[a] += componentSize[b];
+        componentCount--;
+    }
+
+    // Rebuild the union-find from all flights (after the cities change)
+    void resetComponents() {
+        int numCities = cities.size();
+        componentParent.resize(numCities);
+        for (int c = 0; c < numCities; c++) componentParent[c] = c;
+        componentSize.assign(numCities, 1);
+        componentCount = numCities;
+        componentsStale = false;
+        for (int c = 0; c < numCities; c++) {
+            forEachFlight(c, [&](int destination, int) { joinComponents(c, destination); });
+        }
+    }
+
+    // Call visit(destination, cost) for every flight of city, whichever
+    // way the flights are stored (the matrix gives them in city order)
+    template <class Visit>
+    void forEachFlight(int city, Visit visit) const {
+        if (csrOnly) {
+            if (city < 0 || city >= csr.numCities()) return;
+            for (size_t i = csr.offsets[city]; i < csr.offsets[city + 1]; i++) visit(csr.destinations[i], csr.costs[i]);
+            return;
+        }
+        if (matrixMode) {
+            if (city < 0 || city >= linked.size) return;
+            const uint64_t* row = linked.row(city);
+            for (size_t w = 0; w < linked.rowWords; w++) {
+                for (uint64_t bits = row[w]; bits; bits &= bits - 1) {
+                    int destination = w * 64 + __builtin_ctzll(bits);
+                    visit(destination, costMatrix[(size_t)city * linked.size + destination]);
+                }
+            }
+            return;
+        }
+        auto it = adjList.find(city);
+        if (it == adjList.end()) return;
+        for (const Edge& e : it->second) visit(e.destination, e.cost);
+    }
+
+    // Store a flight in the matrix (both directions, keeping the cheapest
+    // cost if the cities are already linked)
+    void setMatrixFlight(int source, int destination, int cost) {
+        size_t n = linked.size;
+        if (!linked.test(source, destination)) {
+            linked.set(source, destination);
+            linked.set(destination, source);
+            costMatrix[source * n + destination] = costMatrix[destination * n + source] = cost;
+            entries += (source == destination) ? 1 : 2;
+        } else if (cost < costMatrix[source * n + destination]) {
+            costMatrix[source * n + destination] = costMatrix[destination * n + source] = cost;
+        }
+    }
+
+    // Move all flights into a matrix sized for the current cities (flights
+    // to cities outside that range cannot be stored and are dropped)
+    void convertToMatrix() {
+        int numCities = cities.size();
+        BitMatrix oldLinked;
+        vector<int> oldCosts;
+        swap(oldLinked, linked);
+        swap(oldCosts, costMatrix);
+        bool wasMatrix = matrixMode;
+        linked.reset(numCities);
+        costMatrix.assign((size_t)numCities * numCities, 0);
+        entries = 0;
+        auto keep = [&](int a, int b, int cost) {
+            if (a >= 0 && b >= 0 && a < numCities && b < numCities) setMatrixFlight(a, b, cost);
+        };
+        if (wasMatrix) {
+            for (int a = 0; a < oldLinked.size; a++) {
+                for (int b = a; b < oldLinked.size; b++) {
+                    if (oldLinked.test(a, b)) keep(a, b, oldCosts[(size_t)a * oldLinked.size + b]);
+                }
+            }
+        } else {
+            for (const auto& entry : adjList) {
+                for (const Edge& e : entry.second) keep(entry.first, e.destination, e.cost);
+            }
+            adjList.clear();
+        }
+        matrixMode = true;
+        frozen = false;
+    }
+
+    // Move all flights from the matrix back into the adjacency list
+    void convertToList() {
+        adjList.clear();
+        entries = 0;
+        for (int a = 0; a < linked.size; a++) {
+            forEachFlight(a, [&](int b, int cost) {
+                adjList[a].push_back(Edge{b, cost});
+                entries++;
+            });
+        }
+        linked = BitMatrix();
+        costMatrix = vector<int>();
+        matrixMode = false;
+        frozen = false;
+    }
+
+    // Before the first change to a loaded network: copy its flights from
+    // the csr arrays into the list (or matrix) that addFlight updates
+    void thaw() {
+        if (!csrOnly) return;
+        int numCities = csr.numCities();
+        size_t total = csr.destinations.size();
+        csrOnly = false;
+        entries = 0;
+        if (storage == ADJ_MATRIX || (storage == AUTO_STORAGE && total >= MATRIX_DENSITY * numCities * numCities)) {
+            matrixMode = true;
+            linked.reset(numCities);
+            costMatrix.assign((size_t)numCities * numCities, 0);
+            for (int c = 0; c < numCities; c++) {
+                for (size_t i = csr.offsets[c]; i < csr.offsets[c + 1]; i++) setMatrixFlight(c, csr.destinations[i], csr.costs[i]);
+            }
+        } else {
+            for (int c = 0; c < numCities; c++) {
+                for (size_t i = csr.offsets[c]; i < csr.offsets[c + 1]; i++) {
+                    adjList[c].push_back(Edge{csr.destinations[i], csr.costs[i]});
+                    entries++;
+                }
+            }
+        }
+    }
+
+    // Make the loaded network (cities plus csr arrays) the current one
+    void adoptCsr() {
+        adjList.clear();
+        linked = BitMatrix();
+        costMatrix = vector<int>();
+        matrixMode = false;
+        entries = csr.destinations.size();
+        frozen = true;
+        csrOnly = true;
+        componentsStale = true;                    // Built on first use: most loads never need it
+    }
+
+    void ensureComponents() {
+        if (componentsStale) resetComponents();
+    }
+
+    // For AUTO_STORAGE: true if the current density calls for the matrix
+    bool denseEnough() const {
+        double pairs = (double)cities.size() * cities.size();
+        return pairs > 0 && entries >= MATRIX_DENSITY * pairs;
+    }
+
+public:
+    explicit Graph(Storage storage = ADJ_LIST) : storage(storage) {}
+
+    // Method to add a flight (edge) between two cities. Returns false, and
+    // leaves the network unchanged, for a city that does not exist (the
+    // matrix has no room for it) or a negative cost (every cheapest route
+    // search here is Dijkstra-based and would silently go wrong).
+    bool addFlight(int source, int destination, int cost) {
+        int numCities = cities.size();
+        if (source < 0 || destination < 0 || source >= numCities || destination >= numCities) return false;
+        if (cost < 0) return false;
+        thaw();
+        if (matrixMode) {
+            setMatrixFlight(source, destination, cost);
+        } else {
+            adjList[source].push_back(Edge{destination, cost});
+            adjList[destination].push_back(Edge{source, cost}); // Assuming undirected graph
+            entries += 2;
+            if (storage == AUTO_STORAGE && denseEnough()) convertToMatrix();
+        }
+        frozen = false;  // The CSR copy is now out of date
+        if (!componentsStale) joinComponents(source, destination);
+        return true;
+    }
+
+    // True while the flights are kept in the bit matrix
+    bool usesMatrix() const {
+        return matrixMode;
+    }
+
+    // Method to list the cities with a flight from city, in city order,
+    // each once. Matrix: scan the bit row. List: sort the flights.
+    vector<int> neighbors(int city) const {
+        vector<int> result;
+        forEachFlight(city, [&](int destination, int) { result.push_back(destination); });
+        if (!matrixMode) {
+            sort(result.begin(), result.end());
+            result.erase(unique(result.begin(), result.end()), result.end());
+        }
+        return result;
+    }
+
+    // Method to list the cities with a flight from both a and b.
+    // Matrix: AND the two bit rows, 64 cities per instruction.
+    // List: merge the two sorted neighbor lists.
+    vector<int> commonNeighbors(int a, int b) const {
+        vector<int> result;
+        if (matrixMode) {
+            const uint64_t* rowA = linked.row(a);
+            const uint64_t* rowB = linked.row(b);
+            for (size_t w = 0; w < linked.rowWords; w++) {
+                for (uint64_t bits = rowA[w] & rowB[w]; bits; bits &= bits - 1) {
+                    result.push_back(w * 64 + __builtin_ctzll(bits));
+                }
+            }
+            return result;
+        }
+        vector<int> na = neighbors(a), nb = neighbors(b);
+        set_intersection(na.begin(), na.end(), nb.begin(), nb.end(), back_inserter(result));
+        return result;
+    }
+
+    // Method to compute which cities can reach which (by any number of
+    // flights) as a bit matrix, using word-parallel Warshall. List
+    // storage is first copied into bit rows.
+    BitMatrix transitiveClosure() const {
+        BitMatrix closure;
+        if (matrixMode) {
+            closure = linked;
+        } else {
+            int numCities = cities.size();
+            closure.reset(numCities);
+            for (int c = 0; c < numCities; c++) {
+                forEachFlight(c, [&](int destination, int) {
+                    if (destination >= 0 && destination < numCities) closure.set(c, destination);
+                });
+            }
+        }
+        warshallClosure(closure);
+        return closure;
+    }
+
+    // Method to check whether two cities are connected by some route: O(α(n))
+    bool sameComponent(int a, int b) {
+        ensureComponents();
+        return findComponent(a) == findComponent(b);
+    }
+
+    // Number of separate groups of cities
+    int numComponents() {
+        ensureComponents();
+        return componentCount;
+    }
+
+    // Method to label every city with a component ID (0, 1, ... in order of
+    // each component's first city) using an iterative breadth-first search
+    // over the CSR arrays
+    vector<int> connectedComponentsSequential() {
+        if (!frozen) freeze();
+        int numCities = csr.numCities();
+        vector<int> component(numCities, -1);
+        vector<int> queue(numCities);
+        int next = 0;
+        for (int start = 0; start < numCities; start++) {
+            if (component[start] != -1) continue;
+            size_t head = 0, tail = 0;
+            queue[tail++] = start;
+            component[start] = next;
+            while (head < tail) {
+                int city = queue[head++];
+                for (size_t i = csr.offsets[city]; i < csr.offsets[city + 1]; i++) {
+                    int d = csr.destinations[i];
+                    if (component[d] == -1) {
+                        component[d] = next;
+                        queue[tail++] = d;
+                    }
+                }
+            }
+            next++;
+        }
+        return component;
+    }
+
+    // Method to label every city with a component ID (same numbering as the
+    // sequential version) using a lock-free union-find: the cities are split
+    // into one block per thread, and each thread unites the endpoints of
+    // the flights leaving its block
+    vector<int> connectedComponents(int threads) {
+        if (!frozen) freeze();
+        int numCities = csr.numCities();
+        if (threads < 1) threads = 1;
+        ConcurrentUnionFind sets(numCities);
+        auto work = [&](int first, int last) {
+            for (int city = first; city < last; city++) {
+                for (size_t i = csr.offsets[city]; i < csr.offsets[city + 1]; i++) {
+                    int d = csr.destinations[i];
+                    if (d > city) sets.unite(city, d);   // Each flight is stored both ways: do it once
+                }
+            }
+        };
+        vector<thread> pool;
+        int block = (numCities + threads - 1) / threads;
+        for (int t = 1; t < threads; t++) {
+            int first = min(numCities, t * block), last = min(numCities, (t + 1) * block);
+            pool.emplace_back(work, first, last);
+        }
+        work(0, min(numCities, block));
+        for (thread& th : pool) th.join();
+
+        // Roots are the smallest city of each set, so numbering roots in
+        // city order gives every component the ID of its first city's rank
+        vector<int> component(numCities);
+        int next = 0;
+        for (int city = 0; city < numCities; city++) {
+            int root = sets.find(city);
+            component[city] = (root == city) ? next++ : component[root];
+        }
+        return component;
+    }
+
+    // Method to build the CSR copy of the network. Traversals use it until
+    // the next addFlight or setCities.
+    void freeze() {
+        if (csrOnly) return;                           // Loaded network: csr is the only copy
+        int numCities = cities.size();
+        csr.offsets.assign(numCities + 1, 0);
+        size_t* offsets = csr.offsets.writable();
+        for (int c = 0; c < numCities; c++) {          // First pass: count valid flights per city
+            size_t count = 0;
+            forEachFlight(c, [&](int destination, int) {
+                if (destination >= 0 && destination < numCities) count++;
+            });
+            offsets[c + 1] = offsets[c] + count;
+        }
+        csr.destinations.resize(offsets[numCities]);
+        csr.costs.resize(offsets[numCities]);
+        int* destinations = csr.destinations.writable();
+        int* costs = csr.costs.writable();
+        for (int c = 0; c < numCities; c++) {          // Second pass: copy them in place
+            size_t pos = offsets[c];
+            forEachFlight(c, [&](int destination, int cost) {
+                if (destination < 0 || destination >= numCities) return;
+                destinations[pos] = destination;
+                costs[pos] = cost;
+                pos++;
+            });
+        }
+        snapshot.reset();                              // Nothing points into a mapped file any more
+        frozen = true;
+    }
+
+    // Method to write the network to a binary snapshot file (see
+    // SnapshotHeader for the layout)
+    bool saveSnapshot(const string& path) {
+        if (!frozen) freeze();
+        ofstream file(path, ios::binary);
+        if (!file) return false;
+        uint64_t n = csr.numCities(), m = csr.destinations.size();
+        vector<uint64_t> nameOffsets(n + 1, 0);
+        for (uint64_t c = 0; c < n; c++) nameOffsets[c + 1] = nameOffsets[c] + cities[c].size();
+        SnapshotHeader header = {{'F', 'N', 'G', 'R'}, SNAPSHOT_VERSION, (uint32_t)n, 0, m, nameOffsets[n]};
+        file.write((const char*)&header, sizeof(header));
+        file.write((const char*)csr.offsets.data(), (n + 1) * sizeof(size_t));
+        file.write((const char*)nameOffsets.data(), (n + 1) * sizeof(uint64_t));
+        file.write((const char*)csr.destinations.data(), m * sizeof(int));
+        int padding = 0;
+        if (m % 2) file.write((const char*)&padding, sizeof(padding));
+        file.write((const char*)csr.costs.data(), m * sizeof(int));
+        for (const string& name : cities) file.write(name.data(), name.size());
+        return (bool)file;
+    }
+
+    // Method to replace the network with one from a snapshot file. The file
+    // is mapped and the flight arrays are used where they lie: nothing is
+    // parsed or copied except the city names. Sizes and indices are checked
+    // first, so a damaged file is rejected instead of crashing a search.
+    bool loadSnapshot(const string& path) {
+        auto file = make_shared<MappedFile>();
+        if (!file->open(path) || file->size() < sizeof(SnapshotHeader)) return false;
+        SnapshotHeader header;
+        memcpy(&header, file->data(), sizeof(header));
+        if (string(header.magic, 4) != "FNGR" || header.version != SNAPSHOT_VERSION || header.reserved != 0) return false;
+        uint64_t n = header.numCities, m = header.numEntries;
+        if (n > (uint64_t)numeric_limits<int>::max() || m > file->size() || header.nameBytes > file->size()) return false;
+        uint64_t paddedEntries = m + m % 2;            // Destinations section rounded up to 8 bytes
+        if (file->size() != sizeof(header) + 2 * (n + 1) * sizeof(uint64_t) + (paddedEntries + m) * sizeof(int) +
+                                header.nameBytes) {
+            return false;
+        }
+        const size_t* offsets = (const size_t*)(file->data() + sizeof(header));
+        const uint64_t* nameOffsets = (const uint64_t*)(offsets + n + 1);
+        const int* destinations = (const int*)(nameOffsets + n + 1);
+        const int* costs = destinations + paddedEntries;
+        const char* names = (const char*)(costs + m);
+
+        if (offsets[0] != 0 || offsets[n] != m || nameOffsets[0] != 0 || nameOffsets[n] != header.nameBytes) return false;
+        for (uint64_t c = 0; c < n; c++) {
+            if (offsets[c] > offsets[c + 1] || nameOffsets[c] > nameOffsets[c + 1]) return false;
+        }
+        bool badFlight = false;                        // Unknown city or negative cost
+        for (uint64_t i = 0; i < m; i++) badFlight |= ((uint64_t)(unsigned)destinations[i] >= n) | (costs[i] < 0);
+        if (badFlight) return false;
+
+        vector<string> newCities(n);
+        for (uint64_t c = 0; c < n; c++) newCities[c].assign(names + nameOffsets[c], nameOffsets[c + 1] - nameOffsets[c]);
+        cities.swap(newCities);
+        csr.offsets.view(offsets, n + 1);
+        csr.destinations.view(destinations, m);
+        csr.costs.view(costs, m);
+        snapshot = file;
+        adoptCsr();
+        return true;
+    }
+
+    // Method to replace the network with one read from an edge-list text
+    // file: one flight per line, "source destination [cost]" with 0-based
+    // city numbers (cost 1 if missing); blank lines and lines starting with
+    // '#' or '%' are skipped. The file is read in 1 MB blocks and the
+    // numbers are parsed by hand, then sorted into csr arrays by city.
+    // Cities are named "City 1", "City 2", ... On failure error says why
+    // and the network is unchanged.
+    bool importEdgeList(const string& path, string& error) {
+        ifstream file(path, ios::binary);
+        if (!file) {
+            error = "cannot open " + path;
+            return false;
+        }
+        vector<int> sources, targets, prices;
+        long long lineNumber = 0;
+        int maxCity = -1;
+        // Parse one line; false (with error set) if it is not a valid flight
+        auto parseLine = [&](const char* p, const char* end) {
+            lineNumber++;
+            while (p < end && (*p == ' ' || *p == '\t' || *p == '\r')) p++;
+            if (p == end || *p == '#' || *p == '%') return true;
+            long long numbers[3];
+            int found = 0;
+            while (p < end && found < 3) {
+                bool negative = (*p == '-');
+                if (negative) p++;
+                if (p == end || *p < '0' || *p > '9') break;
+                long long value = 0;
+                while (p < end && *p >= '0' && *p <= '9' && value <= numeric_limits<int>::max()) value = value * 10 + (*p++ - '0');
+                numbers[found++] = negative ? -value : value;
+                while (p < end && (*p == ' ' || *p == '\t' || *p == '\r' || *p == ',')) p++;
+            }
+            if (found < 2 || p != end || numbers[0] < 0 || numbers[1] < 0 || numbers[0] >= numeric_limits<int>::max() ||
+                numbers[1] >= numeric_limits<int>::max() || (found == 3 && llabs(numbers[2]) > numeric_limits<int>::max())) {
+                error = "line " + to_string(lineNumber) + ": expected \"source destination [cost]\"";
+                return false;
+            }
+            if (found == 3 && numbers[2] < 0) {
+                error = "line " + to_string(lineNumber) + ": negative costs are not supported";
+                return false;
+            }
+            sources.push_back(numbers[0]);
+            targets.push_back(numbers[1]);
+            prices.push_back(found == 3 ? numbers[2] : 1);
+            maxCity = max(maxCity, (int)max(numbers[0], numbers[1]));
+            return true;
+        };
 
-    // DFS helper function for checking connectivity
-    void dfs(int city, vector<bool>& visited) {
-        visited[city] = true;
-        for (const Edge& e : adjList[city]) {
-            if (!visited[e.destination]) {
-                dfs(e.destination, visited);
+        vector<char> block(1 << 20);
+        string partial;                                // Line cut off at the end of the last block
+        while (file) {
+            file.read(block.data(), block.size());
+            size_t got = file.gcount();
+            if (got == 0) break;
+            const char* p = block.data();
+            const char* end = p + got;
+            while (p < end) {
+                const char* newline = (const char*)memchr(p, '\n', end - p);
+                if (!newline) {
+                    partial.append(p, end);
+                    break;
+                }
+                bool ok;
+                if (partial.empty()) {
+                    ok = parseLine(p, newline);
+                } else {
+                    partial.append(p, newline);
+                    ok = parseLine(partial.data(), partial.data() + partial.size());
+                    partial.clear();
+                }
+                if (!ok) return false;
+                p = newline + 1;
             }
         }
+        if (!partial.empty() && !parseLine(partial.data(), partial.data() + partial.size())) return false;
+
+        // Ids are usually dense, so a city id far beyond what the flights can
+        // touch is a typo, and would size the whole network from it
+        size_t flights = sources.size();
+        if ((size_t)maxCity >= 2 * flights + IMPORT_SPARE_CITIES) {
+            error = "city id " + to_string(maxCity) + " is far beyond the " + to_string(flights) +
+                    " flights in the file; renumber the cities from 0";
+            return false;
+        }
+
+        // Counting sort of both directions of every flight by city
+        int n = maxCity + 1;
+        CsrGraph loaded;
+        loaded.offsets.assign(n + 1, 0);
+        size_t* offsets = loaded.offsets.writable();
+        for (size_t f = 0; f < flights; f++) {
+            offsets[sources[f] + 1]++;
+            offsets[targets[f] + 1]++;
+        }
+        for (int c = 0; c < n; c++) offsets[c + 1] += offsets[c];
+        loaded.destinations.resize(2 * flights);
+        loaded.costs.resize(2 * flights);
+        int* destinations = loaded.destinations.writable();
+        int* costs = loaded.costs.writable();
+        vector<size_t> next(offsets, offsets + n);
+        for (size_t f = 0; f < flights; f++) {
+            size_t pos = next[sources[f]]++;
+            destinations[pos] = targets[f];
+            costs[pos] = prices[f];
+            pos = next[targets[f]]++;
+            destinations[pos] = sources[f];
+            costs[pos] = prices[f];
+        }
+
+        vector<string> names(n);
+        for (int c = 0; c < n; c++) names[c] = "City " + to_string(c + 1);
+        cities.swap(names);
+        csr = move(loaded);
+        snapshot.reset();
+        adoptCsr();
+        return true;
     }
 
-public:
-    // Method to add a flight (edge) between two cities
-    void addFlight(int source, int destination, int cost) {
-        adjList[source].push_back(Edge{destination, cost});
-        adjList[destination].push_back(Edge{source, cost}); // Assuming undirected graph
+    bool isFrozen() const {
+        return frozen;
     }
 
-    // Method to check if the graph is connected
-    bool isConnected() {
+    // The CSR copy of the network, frozen first if needed
+    const CsrGraph& frozenView() {
+        if (!frozen) freeze();
+        return csr;
+    }
+
+    // Number of cities reachable from start (itself included), walking the
+    // adjacency list map with an explicit stack
+    int countReachableList(int start) {
         int numCities = cities.size();
         vector<bool> visited(numCities, false);
-        dfs(0, visited); // Start DFS from the first city
+        vector<int> pending(1, start);
+        visited[start] = true;
+        int count = 0;
+        while (!pending.empty()) {
+            int city = pending.back();
+            pending.pop_back();
+            count++;
+            forEachFlight(city, [&](int destination, int) {
+                if (destination >= 0 && destination < numCities && !visited[destination]) {
+                    visited[destination] = true;
+                    pending.push_back(destination);
+                }
+            });
+        }
+        return count;
+    }
+
+    // Same traversal over the CSR arrays (freezes first if needed)
+    int countReachableFrozen(int start) {
+        if (!frozen) freeze();
+        vector<bool> visited(csr.numCities(), false);
+        vector<int> pending(1, start);
+        visited[start] = true;
+        int count = 0;
+        while (!pending.empty()) {
+            int city = pending.back();
+            pending.pop_back();
+            count++;
+            for (size_t i = csr.offsets[city]; i < csr.offsets[city + 1]; i++) {
+                int next = csr.destinations[i];
+                if (!visited[next]) {
+                    visited[next] = true;
+                    pending.push_back(next);
+                }
+            }
+        }
+        return count;
+    }
+
+    // Method to find how many flights each city is from source, looking at
+    // most maxHops flights deep (maxHops < 0: no limit)
+    BfsResult hopDistances(int source, int maxHops, int threads, bool directionOptimizing = true) {
+        if (!frozen) freeze();
+        return breadthFirstSearch(csr, source, maxHops, threads, directionOptimizing);
+    }
+
+    // Method to list the cities reachable from source with at most hops flights
+    vector<int> reachableWithin(int source, int hops, int threads) {
+        BfsResult bfs = hopDistances(source, hops, threads);
+        vector<int> cities;
+        for (int c = 0; c < (int)bfs.hops.size(); c++) {
+            if (c != source && bfs.hops[c] >= 0) cities.push_back(c);
+        }
+        return cities;
+    }
+
+    // Approximate memory of the adjacency list map (nodes, buckets, vectors)
+    size_t listBytes() const {
+        size_t bytes = adjList.bucket_count() * sizeof(void*);
+        for (const auto& entry : adjList) {
+            bytes += sizeof(entry) + sizeof(void*) + entry.second.capacity() * sizeof(Edge);
+        }
+        return bytes;
+    }
 
-        // Check if all cities have been visited
-        for (bool v : visited) {
-            if (!v) {
-                return false;  // If any city is not visited, the network is not connected
+    // Memory of the bit rows and cost matrix
+    size_t matrixBytes() const {
+        return linked.bits.capacity() * sizeof(uint64_t) + costMatrix.capacity() * sizeof(int);
+    }
+
+    // Memory of the CSR arrays
+    size_t csrBytes() const {
+        return csr.offsets.size() * sizeof(size_t) + csr.destinations.size() * sizeof(int) +
+               csr.costs.size() * sizeof(int);
+    }
+
+    // Number of flight entries (each undirected flight is stored twice)
+    // (the matrix keeps one entry per linked pair of cities)
+    size_t flightEntries() const {
+        return entries;
+    }
+
+    // Method to compute the cheapest cost from source to every city
+    // (NO_ROUTE for unreachable ones)
+    vector<long long> cheapestCosts(int source) {
+        search(source, -1, [](int) { return 0LL; });
+        return forward.dist;
+    }
+
+    // Method to compute the cheapest cost between every pair of cities into
+    // d (APSP_UNREACHABLE where there is no route), using Floyd-Warshall or
+    // one Dijkstra per city (see AllPairsMethod), on the given number of
+    // threads. Fails, with error set, on negative costs or if a route
+    // could cost more than the 32-bit matrix holds.
+    bool allPairsCosts(DistanceMatrix& d, int threads, AllPairsMethod method, string& error, bool allowSimd = true) {
+        if (!frozen) freeze();
+        int numCities = csr.numCities();
+        if (threads < 1) threads = 1;
+        long long maxCost = 0;
+        for (size_t i = 0; i < csr.costs.size(); i++) {
+            if (csr.costs[i] < 0) {
+                error = "negative flight costs are not supported";
+                return false;
+            }
+            maxCost = max(maxCost, (long long)csr.costs[i]);
+        }
+        if (maxCost * max(numCities - 1, 1) >= APSP_UNREACHABLE) {   // Longest possible route
+            error = "flight costs too large for a 32-bit cost matrix";
+            return false;
+        }
+        if (method == APSP_AUTO) {
+            bool dense = preferFloydWarshall(numCities, csr.destinations.size());
+            method = dense ? APSP_FLOYD_WARSHALL : APSP_DIJKSTRA;
+        }
+
+        d.reset(numCities);
+        if (method == APSP_FLOYD_WARSHALL) {
+            for (int c = 0; c < numCities; c++) {
+                int* row = d.row(c);
+                for (size_t i = csr.offsets[c]; i < csr.offsets[c + 1]; i++) {
+                    row[csr.destinations[i]] = min(row[csr.destinations[i]], csr.costs[i]);
+                }
+            }
+            floydWarshallTiled(d, threads, allowSimd);
+            return true;
+        }
+
+        // One Dijkstra per city; each thread has its own search state and
+        // writes only the rows of its own source cities
+        runThreads(threads, [&](int t) {
+            SearchState state;
+            for (int source = t; source < numCities; source += threads) {
+                dijkstraSearch(csr, state, source, -1, [](int) { return 0LL; });
+                int* row = d.row(source);
+                for (int c : state.touched) row[c] = state.dist[c];
+            }
+        });
+        return true;
+    }
+
+    // Method to find the cheapest route between two cities (Dijkstra)
+    Route cheapestRoute(int source, int destination) {
+        return search(source, destination, [](int) { return 0LL; });
+    }
+
+    // Method to find the cheapest route with A*. heuristic(city) must never
+    // overestimate the remaining cost to destination, and must be consistent:
+    // heuristic(a) <= cost(a, b) + heuristic(b) for every flight a-b.
+    template <class Heuristic>
+    Route cheapestRouteAStar(int source, int destination, Heuristic heuristic) {
+        return search(source, destination, heuristic);
+    }
+
+    // Method to find the cheapest route with bidirectional Dijkstra: one
+    // search from each end, always advancing the side with the smaller
+    // frontier cost, until the two frontiers together cannot beat the best
+    // meeting point found. Flights are undirected, so the backward search
+    // uses the same arrays.
+    Route cheapestRouteBidirectional(int source, int destination) {
+        if (!frozen) freeze();
+        Route route;
+        int numCities = csr.numCities();
+        forward.prepare(numCities);
+        backward.prepare(numCities);
+        forward.label(source, 0, -1);
+        forward.heap.push(0, source);
+        backward.label(destination, 0, -1);
+        backward.heap.push(0, destination);
+        long long best = (source == destination) ? 0 : NO_ROUTE;
+        int meet = (source == destination) ? source : -1;
+
+        while (!forward.heap.empty() && !backward.heap.empty()) {
+            long long topForward = forward.heap.top().first, topBackward = backward.heap.top().first;
+            if (best != NO_ROUTE && topForward + topBackward >= best) break;  // No better meeting possible
+            bool goForward = topForward <= topBackward;
+            SearchState& side = goForward ? forward : backward;
+            SearchState& other = goForward ? backward : forward;
+            int city = side.heap.top().second;
+            side.heap.pop();
+            if (side.done[city]) continue;
+            side.done[city] = 1;
+            route.settled++;
+            long long base = side.dist[city];
+            for (size_t i = csr.offsets[city]; i < csr.offsets[city + 1]; i++) {
+                int next = csr.destinations[i];
+                long long cost = base + csr.costs[i];
+                if (cost >= side.dist[next]) continue;
+                side.label(next, cost, city);
+                side.heap.push(cost, next);
+                if (other.dist[next] != NO_ROUTE && cost + other.dist[next] < best) {
+                    best = cost + other.dist[next];    // The two searches meet at next
+                    meet = next;
+                }
+            }
+        }
+        if (meet != -1) {
+            route.cost = best;
+            appendPath(forward, meet, route.path);     // meet .. source
+            reverse(route.path.begin(), route.path.end());
+            for (int c = backward.parent[meet]; c != -1; c = backward.parent[c]) {
+                route.path.push_back(c);               // .. destination
             }
         }
-        return true;  // All cities are visited, so the network is connected
+        return route;
+    }
+
+    // Method to get the name of a city
+    const string& cityName(int index) const {
+        return cities[index];
+    }
+
+    int numCities() const {
+        return cities.size();
+    }
+
+    // Method to check if the graph is connected: O(1), the union-find
+    // already knows how many separate groups there are
+    bool isConnected() {
+        ensureComponents();
+        return componentCount <= 1;
     }
 
     // Method to display all the cities in the flight network
@@ -60,24 +1719,453 @@ public:
 
     // Method to set cities
     void setCities(const vector<string>& cityNames) {
+        thaw();
         cities = cityNames;
+        frozen = false;
+        if (storage == ADJ_MATRIX || (storage == AUTO_STORAGE && denseEnough())) {
+            convertToMatrix();                     // Matrix sized for the new cities
+        } else if (matrixMode) {
+            convertToList();                       // Too sparse now for the matrix
+        }
+        resetComponents();
     }
 
     // Method to display the flights
     void displayFlights() {
-        cout << "\nFlight Network (Adjacency List Representation): \n";
+        cout << "\nFlight Network (" << (matrixMode ? "Adjacency Matrix" : "Adjacency List") << " Representation): \n";
         for (int i = 0; i < cities.size(); ++i) {
             cout << cities[i] << " -> ";
-            for (const Edge& e : adjList[i]) {
-                cout << cities[e.destination] << "(Cost: " << e.cost << ") ";
-            }
+            forEachFlight(i, [&](int destination, int cost) {
+                if (destination < 0 || destination >= (int)cities.size()) return;  // City removed by setCities
+                cout << cities[destination] << "(Cost: " << cost << ") ";
+            });
             cout << endl;
         }
     }
 };
 
+// Benchmark: traversal over the adjacency list map vs. the frozen CSR copy
+// on a random connected network
+void benchmarkTraversal(int numCities, long long numFlights) {
+    Graph network;
+    vector<string> names(numCities);
+    for (int i = 0; i < numCities; i++) names[i] = "City " + to_string(i + 1);
+    network.setCities(names);
+
+    mt19937 rng(41);
+    auto start = chrono::steady_clock::now();
+    for (int i = 1; i < numCities; i++) {            // Random spanning tree keeps it connected
+        network.addFlight(rng() % i, i, 1 + rng() % 1000);
+    }
+    for (long long f = numCities - 1; f < numFlights; f++) {
+        network.addFlight(rng() % numCities, rng() % numCities, 1 + rng() % 1000);
+    }
+    double buildTime = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    start = chrono::steady_clock::now();
+    network.freeze();
+    double freezeTime = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    const int ROUNDS = 3;
+    double listTime = 0, csrTime = 0;
+    int reachedList = 0, reachedCsr = 0;
+    for (int r = 0; r < ROUNDS; r++) {
+        start = chrono::steady_clock::now();
+        reachedList = network.countReachableList(0);
+        listTime += chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        start = chrono::steady_clock::now();
+        reachedCsr = network.countReachableFrozen(0);
+        csrTime += chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    }
+    double edges = (double)network.flightEntries() * ROUNDS;  // Every entry is scanned once per traversal
+
+    cout << "Cities: " << numCities << ", flights: " << numFlights << " (build " << buildTime * 1000
+         << " ms, freeze " << freezeTime * 1000 << " ms)\n";
+    cout << "  Map of vectors: " << listTime / ROUNDS * 1000 << " ms/traversal, " << edges / listTime / 1e6
+         << " M edges/s, " << network.listBytes() / 1e6 << " MB, reached " << reachedList << "\n";
+    cout << "  CSR           : " << csrTime / ROUNDS * 1000 << " ms/traversal, " << edges / csrTime / 1e6
+         << " M edges/s, " << network.csrBytes() / 1e6 << " MB, reached " << reachedCsr << "\n";
+}
+
+// Function to fill network with a random road-like network: cities are
+// scattered over a square grid (coordinates returned in x and y), each
+// linked to nearby cities, and a flight costs its length x10, rounded up.
+// Every HIGHWAY_SPACING-th row and column is a trunk route at FAST_SPEED
+// times the speed (cost divided accordingly), giving the network the
+// hierarchy real transport networks have. Returns the number of flights.
+const int HIGHWAY_SPACING = 16;
+const double FAST_SPEED = 4.0;
+
+long long makeGeometricNetwork(Graph& network, int numCities, vector<double>& x, vector<double>& y) {
+    int side = (int)ceil(sqrt((double)numCities));
+    mt19937 rng(42);
+    uniform_real_distribution<double> jitter(0.0, 0.8);
+    x.resize(numCities);
+    y.resize(numCities);
+    vector<string> names(numCities);
+    for (int i = 0; i < numCities; i++) {
+        x[i] = i % side + jitter(rng);
+        y[i] = i / side + jitter(rng);
+        names[i] = "City " + to_string(i + 1);
+    }
+    network.setCities(names);
+    long long flights = 0;
+    for (int i = 0; i < numCities; i++) {
+        int column = i % side, diagonal = column + (int)(rng() % 3) - 1;
+        int neighbors[3] = {column + 1 < side ? i + 1 : -1, i + side,
+                            diagonal >= 0 && diagonal < side ? i + side + diagonal - column : -1};
+        for (int j : neighbors) {                      // Right, below, and a random diagonal
+            if (j <= i || j >= numCities) continue;
+            double length = sqrt((x[i] - x[j]) * (x[i] - x[j]) + (y[i] - y[j]) * (y[i] - y[j]));
+            bool highway = (j == i + 1 && (i / side) % HIGHWAY_SPACING == 0) ||
+                           (j == i + side && column % HIGHWAY_SPACING == 0);
+            network.addFlight(i, j, (int)ceil(10 * length / (highway ? FAST_SPEED : 1.0)));
+            flights++;
+        }
+    }
+    return flights;
+}
+
+// Benchmark: Dijkstra, bidirectional Dijkstra and A* on a geometric
+// network, where the straight line distance to the destination at highway
+// speed is a consistent A* heuristic
+void benchmarkShortestPaths(int numCities, int queries) {
+    Graph network;
+    vector<double> x, y;
+    long long flights = makeGeometricNetwork(network, numCities, x, y);
+    auto length = [&](int a, int b) { return sqrt((x[a] - x[b]) * (x[a] - x[b]) + (y[a] - y[b]) * (y[a] - y[b])); };
+    mt19937 rng(43);
+    auto start = chrono::steady_clock::now();
+    network.freeze();
+    double freezeTime = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    start = chrono::steady_clock::now();
+    vector<long long> all = network.cheapestCosts(0);
+    double singleTime = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    int reached = 0;
+    for (long long c : all) reached += (c != NO_ROUTE);
+
+    double time[3] = {0, 0, 0};
+    long long settled[3] = {0, 0, 0};
+    int mismatches = 0;
+    for (int q = 0; q < queries; q++) {
+        int s = rng() % numCities, t = rng() % numCities;
+        auto heuristic = [&](int c) { return (long long)floor(10 * length(c, t) / FAST_SPEED); };
+        Route routes[3];
+        for (int algo = 0; algo < 3; algo++) {
+            start = chrono::steady_clock::now();
+            if (algo == 0) routes[algo] = network.cheapestRoute(s, t);
+            else if (algo == 1) routes[algo] = network.cheapestRouteBidirectional(s, t);
+            else routes[algo] = network.cheapestRouteAStar(s, t, heuristic);
+            time[algo] += chrono::duration<double>(chrono::steady_clock::now() - start).count();
+            settled[algo] += routes[algo].settled;
+        }
+        if (routes[1].cost != routes[0].cost || routes[2].cost != routes[0].cost) mismatches++;
+    }
+
+    cout << "Cities: " << numCities << ", flights: " << flights << ", freeze: " << freezeTime * 1000 << " ms\n";
+    cout << "  Single source (4-ary heap): " << singleTime * 1000 << " ms, reached " << reached << " cities\n";
+    const char* labels[3] = {"Dijkstra      ", "Bidirectional ", "A*            "};
+    for (int algo = 0; algo < 3; algo++) {
+        cout << "  " << labels[algo] << ": " << time[algo] / queries * 1000 << " ms/query, "
+             << settled[algo] / queries << " cities settled/query\n";
+    }
+    cout << "  Cost mismatches: " << mismatches << " of " << queries << " queries\n";
+}
+
+// Benchmark: contraction hierarchy preprocessing, file round trip and
+// query latency against bidirectional Dijkstra
+void benchmarkContraction(int numCities, int queries) {
+    Graph network;
+    vector<double> x, y;
+    long long flights = makeGeometricNetwork(network, numCities, x, y);
+    ContractionHierarchy ch;
+    auto start = chrono::steady_clock::now();
+    ch.build(network.frozenView());
+    double buildTime = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    const string path = "flight_network.ch";
+    start = chrono::steady_clock::now();
+    bool saved = ch.save(path);
+    ContractionHierarchy loaded;
+    bool ok = saved && loaded.load(path);
+    double fileTime = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    remove(path.c_str());
+
+    mt19937 rng(44);
+    double chTime = 0, dijkstraTime = 0;
+    long long chSettled = 0, dijkstraSettled = 0;
+    int mismatches = 0;
+    for (int q = 0; q < queries; q++) {
+        int s = rng() % numCities, t = rng() % numCities;
+        start = chrono::steady_clock::now();
+        long long cost = loaded.query(s, t);
+        chTime += chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        chSettled += loaded.lastSettled;
+        start = chrono::steady_clock::now();
+        Route route = network.cheapestRouteBidirectional(s, t);
+        dijkstraTime += chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        dijkstraSettled += route.settled;
+        if (cost != route.cost) mismatches++;
+    }
+
+    cout << "Cities: " << numCities << ", flights: " << flights << "\n";
+    cout << "  Preprocessing: " << buildTime * 1000 << " ms, " << ch.shortcuts << " shortcuts\n";
+    cout << "  Save + load (" << path << "): " << fileTime * 1000 << " ms" << (ok ? "" : " (FAILED)") << "\n";
+    cout << "  CH query           : " << chTime / queries * 1e6 << " us/query, "
+         << chSettled / queries << " cities settled/query\n";
+    cout << "  Bidirectional query: " << dijkstraTime / queries * 1e6 << " us/query, "
+         << dijkstraSettled / queries << " cities settled/query\n";
+    cout << "  Cost mismatches: " << mismatches << " of " << queries << " queries\n";
+}
+
+// Benchmark: component labeling by sequential BFS vs. the lock-free
+// union-find with 1, 2, 4 ... threads on a random network
+void benchmarkComponents(int numCities, long long numFlights) {
+    Graph network;
+    vector<string> names(numCities);
+    for (int i = 0; i < numCities; i++) names[i] = "City " + to_string(i + 1);
+    network.setCities(names);
+    mt19937 rng(44);
+    auto start = chrono::steady_clock::now();
+    for (long long f = 0; f < numFlights; f++) {     // Incremental union-find runs inside addFlight
+        network.addFlight(rng() % numCities, rng() % numCities, 1 + rng() % 1000);
+    }
+    double buildTime = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    network.freeze();
+
+    start = chrono::steady_clock::now();
+    vector<int> expected = network.connectedComponentsSequential();
+    double bfsTime = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    cout << "Cities: " << numCities << ", flights: " << numFlights << ", components: "
+         << network.numComponents() << " (tracked by addFlight; " << buildTime * 1000 << " ms to add all flights)\n";
+    cout << "  Sequential BFS          : " << bfsTime * 1000 << " ms\n";
+    int maxThreads = max(1u, thread::hardware_concurrency());
+    for (int threads = 1; threads <= maxThreads; threads *= 2) {
+        start = chrono::steady_clock::now();
+        vector<int> component = network.connectedComponents(threads);
+        double t = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        cout << "  Union-find, " << threads << (threads == 1 ? " thread ": " threads") << (threads < 10 ? " " : "")
+             << "  : " << t * 1000 << " ms" << (component == expected ? "" : " (LABELS DIFFER)") << "\n";
+    }
+}
+
+// Benchmark: hop distances from random sources on a random network,
+// top-down only vs. direction-optimizing, with 1, 2, 4 ... threads.
+// Speed is in traversed edges per second (TEPS): flights inside the part
+// of the network reached, divided by the search time.
+void benchmarkBfs(int numCities, long long numFlights, int sources) {
+    Graph network;
+    vector<string> names(numCities);
+    for (int i = 0; i < numCities; i++) names[i] = "City " + to_string(i + 1);
+    network.setCities(names);
+    mt19937 rng(45);
+    for (long long f = 0; f < numFlights; f++) {
+        network.addFlight(rng() % numCities, rng() % numCities, 1 + rng() % 1000);
+    }
+    network.freeze();
+    const CsrGraph& g = network.frozenView();
+
+    vector<int> starts;
+    while ((int)starts.size() < sources) {            // Skip cities without flights
+        int city = rng() % numCities;
+        if (g.offsets[city + 1] > g.offsets[city]) starts.push_back(city);
+    }
+    vector<BfsResult> expected;
+    for (int s : starts) expected.push_back(network.hopDistances(s, -1, 1, false));
+
+    cout << "Cities: " << numCities << ", flights: " << numFlights << ", sources: " << sources
+         << ", cities reached from the first: " << expected[0].reached
+         << " in " << expected[0].levels << " levels\n";
+    int maxThreads = max(1u, thread::hardware_concurrency());
+    for (int mode = 0; mode < 2; mode++) {
+        for (int threads = 1; threads <= maxThreads; threads *= 2) {
+            double time = 0, traversed = 0, checked = 0;
+            int bottomUpLevels = 0;
+            bool same = true;
+            for (int i = 0; i < sources; i++) {
+                auto start = chrono::steady_clock::now();
+                BfsResult bfs = network.hopDistances(starts[i], -1, threads, mode == 1);
+                time += chrono::duration<double>(chrono::steady_clock::now() - start).count();
+                for (int c = 0; c < numCities; c++) {
+                    if (bfs.hops[c] >= 0) traversed += g.offsets[c + 1] - g.offsets[c];
+                }
+                checked += bfs.edgesChecked;
+                bottomUpLevels += bfs.bottomUpLevels;
+                same = same && bfs.hops == expected[i].hops;
+            }
+            cout << "  " << (mode ? "Direction-optimizing" : "Top-down only       ") << ", " << threads
+                 << (threads == 1 ? " thread : " : " threads: ") << time * 1000 / sources << " ms/search, "
+                 << traversed / 2 / time / 1e6 << " MTEPS, " << (long long)(checked / sources)
+                 << " entries checked/search";
+            if (mode) cout << ", " << (double)bottomUpLevels / sources << " bottom-up levels";
+            cout << (same ? "" : " (HOPS DIFFER)") << "\n";
+        }
+    }
+}
+
+// Benchmark: the same dense random network stored as a list and as a
+// matrix; neighbor enumeration, common neighbors and transitive closure
+void benchmarkMatrix(int numCities, double density, int pairs) {
+    Graph listNetwork(ADJ_LIST), matrixNetwork(ADJ_MATRIX), autoNetwork(AUTO_STORAGE);
+    vector<string> names(numCities);
+    for (int i = 0; i < numCities; i++) names[i] = "City " + to_string(i + 1);
+    listNetwork.setCities(names);
+    matrixNetwork.setCities(names);
+    autoNetwork.setCities(names);
+    mt19937 rng(46);
+    uniform_real_distribution<double> coin(0.0, 1.0);
+    long long numFlights = 0;
+    for (int a = 0; a < numCities; a++) {
+        for (int b = a + 1; b < numCities; b++) {
+            if (coin(rng) >= density) continue;
+            int cost = 1 + rng() % 1000;
+            listNetwork.addFlight(a, b, cost);
+            matrixNetwork.addFlight(a, b, cost);
+            autoNetwork.addFlight(a, b, cost);
+            numFlights++;
+        }
+    }
+    cout << "Cities: " << numCities << ", flights: " << numFlights << " (automatic choice: "
+         << (autoNetwork.usesMatrix() ? "matrix" : "list") << ")\n";
+    cout << "  Memory: list " << listNetwork.listBytes() / 1e6 << " MB, matrix "
+         << matrixNetwork.matrixBytes() / 1e6 << " MB\n";
+
+    Graph* networks[2] = {&listNetwork, &matrixNetwork};
+    const char* labels[2] = {"List  ", "Matrix"};
+    vector<pair<int, int>> queries(pairs);
+    for (auto& q : queries) q = make_pair(rng() % numCities, rng() % numCities);
+    long long checksum[2] = {0, 0};
+    vector<BitMatrix> closures(2);
+    for (int i = 0; i < 2; i++) {
+        auto start = chrono::steady_clock::now();
+        for (int c = 0; c < numCities; c++) checksum[i] += networks[i]->neighbors(c).size();
+        double neighborTime = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+        start = chrono::steady_clock::now();
+        for (const auto& q : queries) checksum[i] += networks[i]->commonNeighbors(q.first, q.second).size();
+        double commonTime = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+        start = chrono::steady_clock::now();
+        closures[i] = networks[i]->transitiveClosure();
+        double closureTime = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+        cout << "  " << labels[i] << ": neighbors of every city " << neighborTime * 1000 << " ms, "
+             << pairs << " common-neighbor queries " << commonTime * 1000 << " ms, transitive closure "
+             << closureTime * 1000 << " ms\n";
+    }
+    if (checksum[0] != checksum[1] || closures[0].bits != closures[1].bits) {
+        cout << "  RESULTS DIFFER between list and matrix\n";
+    }
+}
+
+// Benchmark: write a random edge list, import it, save it as a snapshot
+// and load the snapshot back; the loaded network must match the imported
+// one. The benchmark files are deleted afterwards.
+void benchmarkSnapshot(int numCities, long long numFlights) {
+    const string textPath = "flight_network_bench.txt", snapshotPath = "flight_network_bench.fngr";
+    mt19937 rng(47);
+    auto start = chrono::steady_clock::now();
+    {
+        ofstream text(textPath, ios::binary);
+        string chunk;
+        text << "# " << numCities << " cities, " << numFlights << " flights\n";
+        for (long long f = 0; f < numFlights; f++) {
+            chunk += to_string(rng() % numCities) + ' ' + to_string(rng() % numCities) + ' ' + to_string(1 + rng() % 1000) + '\n';
+            if (chunk.size() > (1 << 20)) {
+                text << chunk;
+                chunk.clear();
+            }
+        }
+        text << chunk;
+    }
+    double writeTextTime = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    Graph imported, loaded;
+    string error;
+    start = chrono::steady_clock::now();
+    bool ok = imported.importEdgeList(textPath, error);
+    double importTime = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    if (!ok) {
+        cout << "Import failed: " << error << "\n";
+        remove(textPath.c_str());
+        return;
+    }
+    start = chrono::steady_clock::now();
+    ok = imported.saveSnapshot(snapshotPath);
+    double saveTime = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    start = chrono::steady_clock::now();
+    ok = ok && loaded.loadSnapshot(snapshotPath);
+    double loadTime = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    const CsrGraph& a = imported.frozenView();
+    const CsrGraph& b = loaded.frozenView();
+    bool same = ok && a.numCities() == b.numCities() && a.destinations.size() == b.destinations.size() &&
+                equal(a.offsets.data(), a.offsets.data() + a.offsets.size(), b.offsets.data()) &&
+                equal(a.destinations.data(), a.destinations.data() + a.destinations.size(), b.destinations.data()) &&
+                equal(a.costs.data(), a.costs.data() + a.costs.size(), b.costs.data());
+    int source = rng() % a.numCities();
+    same = same && imported.cheapestCosts(source) == loaded.cheapestCosts(source);
+
+    cout << "Cities: " << a.numCities() << ", flights: " << numFlights << "\n";
+    cout << "  Write edge list text: " << writeTextTime * 1000 << " ms\n";
+    cout << "  Import edge list    : " << importTime * 1000 << " ms\n";
+    cout << "  Save snapshot       : " << saveTime * 1000 << " ms\n";
+    cout << "  Load snapshot (mmap): " << loadTime * 1000 << " ms" << (same ? "" : " (NETWORKS DIFFER)") << "\n";
+    remove(textPath.c_str());
+    remove(snapshotPath.c_str());
+}
+
+// Benchmark: all-pairs costs on a random network with Floyd-Warshall
+// (scalar, AVX2, all threads) and repeated Dijkstra (1 and all threads)
+void benchmarkAllPairs(int numCities, int degree) {
+    Graph network;
+    vector<string> names(numCities);
+    for (int i = 0; i < numCities; i++) names[i] = "City " + to_string(i + 1);
+    network.setCities(names);
+    mt19937 rng(48);
+    long long numFlights = (long long)numCities * degree / 2;
+    for (long long f = 0; f < numFlights; f++) {
+        network.addFlight(rng() % numCities, rng() % numCities, 1 + rng() % 1000);
+    }
+    network.freeze();
+    int maxThreads = max(1u, thread::hardware_concurrency());
+    cout << "Cities: " << numCities << ", flights: " << numFlights << ", matrix: "
+         << (double)numCities * numCities * sizeof(int) / 1e6 << " MB\n";
+
+    struct Run { const char* label; AllPairsMethod method; int threads; bool simd; };
+    vector<Run> runs = {{"Floyd-Warshall scalar, 1 thread", APSP_FLOYD_WARSHALL, 1, false},
+                        {"Floyd-Warshall AVX2,   1 thread", APSP_FLOYD_WARSHALL, 1, true},
+                        {"Floyd-Warshall AVX2, all threads", APSP_FLOYD_WARSHALL, maxThreads, true},
+                        {"Dijkstra,              1 thread", APSP_DIJKSTRA, 1, true},
+                        {"Dijkstra,         all threads", APSP_DIJKSTRA, maxThreads, true}};
+    DistanceMatrix first;
+    for (size_t r = 0; r < runs.size(); r++) {
+        if (runs[r].simd && runs[r].method == APSP_FLOYD_WARSHALL && !cpuHasAvx2()) {
+            cout << "  " << runs[r].label << ": AVX2 not supported on this CPU\n";
+            continue;
+        }
+        DistanceMatrix d;
+        string error;
+        auto start = chrono::steady_clock::now();
+        if (!network.allPairsCosts(d, runs[r].threads, runs[r].method, error, runs[r].simd)) {
+            cout << "  " << runs[r].label << ": " << error << "\n";
+            return;
+        }
+        double t = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        bool same = true;
+        if (r == 0) first = move(d);
+        else same = d.cells == first.cells;
+        cout << "  " << runs[r].label << ": " << t * 1000 << " ms" << (same ? "" : " (COSTS DIFFER)") << "\n";
+    }
+    cout << "  Automatic choice: "
+         << (preferFloydWarshall(numCities, numFlights * 2) ? "Floyd-Warshall" : "Dijkstra") << "\n";
+}
+
 int main() {
-    Graph flightNetwork;
+    Graph flightNetwork(AUTO_STORAGE);    // List while sparse, matrix once dense
+    ContractionHierarchy hierarchy;        // Built from (or loaded for) the current network
     vector<string> cities;
     vector<tuple<int, int, int>> flights;
     int choice;
@@ -91,7 +2179,28 @@ int main() {
         cout << "3. Display Cities\n";
         cout << "4. Display Flight Network\n";
         cout << "5. Check Connectivity\n";
-        cout << "6. Exit\n";
+        cout << "6. Freeze Network (CSR)\n";
+        cout << "7. Benchmark Traversal (Map vs CSR)\n";
+        cout << "8. Find Cheapest Route\n";
+        cout << "9. Benchmark Shortest Paths\n";
+        cout << "10. Build Contraction Hierarchy\n";
+        cout << "11. Save Contraction Hierarchy\n";
+        cout << "12. Load Contraction Hierarchy\n";
+        cout << "13. Query Cheapest Cost (Contraction Hierarchy)\n";
+        cout << "14. Benchmark Contraction Hierarchy\n";
+        cout << "15. Show Connected Components\n";
+        cout << "16. Benchmark Connected Components\n";
+        cout << "17. Find Cities Within k Hops\n";
+        cout << "18. Benchmark BFS\n";
+        cout << "19. Find Common Neighbors\n";
+        cout << "20. Benchmark Matrix vs List (Dense Network)\n";
+        cout << "21. Save Network Snapshot\n";
+        cout << "22. Load Network Snapshot\n";
+        cout << "23. Import Edge List\n";
+        cout << "24. Benchmark Snapshot Loading\n";
+        cout << "25. Show All-Pairs Cheapest Costs\n";
+        cout << "26. Benchmark All-Pairs Cheapest Costs\n";
+        cout << "27. Exit\n";
         cout << "Enter your choice: ";
         cin >> choice;
 
@@ -125,8 +2234,13 @@ int main() {
                 cin >> cost;
 
                 // Add flight to the network
-                flightNetwork.addFlight(sourceIndex - 1, destIndex - 1, cost);
-                cout << "Flight added successfully!\n";
+                if (flightNetwork.addFlight(sourceIndex - 1, destIndex - 1, cost)) {
+                    cout << "Flight added successfully!\n";
+                } else if (cost < 0) {
+                    cout << "Flight not added: costs cannot be negative.\n";
+                } else {
+                    cout << "Flight not added: invalid city index.\n";
+                }
                 break;
             }
 
@@ -153,6 +2267,310 @@ int main() {
             }
 
             case 6: {
+                // Freeze: build the CSR copy used by traversals
+                flightNetwork.freeze();
+                cout << "Flight network frozen into CSR form.\n";
+                break;
+            }
+
+            case 7: {
+                // Benchmark traversal on a random network
+                int numCities;
+                long long numFlights;
+                cout << "Enter number of cities (e.g. 200000): ";
+                cin >> numCities;
+                cout << "Enter number of flights (e.g. 10000000): ";
+                cin >> numFlights;
+                if (numCities > 0 && numFlights >= numCities - 1) {
+                    benchmarkTraversal(numCities, numFlights);
+                } else {
+                    cout << "Need at least (cities - 1) flights.\n";
+                }
+                break;
+            }
+
+            case 8: {
+                // Cheapest route between two cities
+                int sourceIndex, destIndex;
+                flightNetwork.displayCities();
+                cout << "Enter source city index (1-based): ";
+                cin >> sourceIndex;
+                cout << "Enter destination city index (1-based): ";
+                cin >> destIndex;
+                int numCities = flightNetwork.numCities();
+                if (sourceIndex < 1 || sourceIndex > numCities || destIndex < 1 || destIndex > numCities) {
+                    cout << "Invalid city index.\n";
+                    break;
+                }
+                Route route = flightNetwork.cheapestRouteBidirectional(sourceIndex - 1, destIndex - 1);
+                if (route.cost == NO_ROUTE) {
+                    cout << "No route between these cities.\n";
+                } else {
+                    cout << "Cheapest cost: " << route.cost << "\nRoute: ";
+                    for (size_t i = 0; i < route.path.size(); i++) {
+                        cout << (i ? " -> " : "") << flightNetwork.cityName(route.path[i]);
+                    }
+                    cout << endl;
+                }
+                break;
+            }
+
+            case 9: {
+                // Benchmark shortest path algorithms on a random network
+                int numCities, queries;
+                cout << "Enter number of cities (e.g. 1000000): ";
+                cin >> numCities;
+                cout << "Enter number of queries (e.g. 20): ";
+                cin >> queries;
+                if (numCities > 1 && queries > 0) {
+                    benchmarkShortestPaths(numCities, queries);
+                }
+                break;
+            }
+
+            case 10: {
+                // Preprocess the current network
+                auto start = chrono::steady_clock::now();
+                hierarchy.build(flightNetwork.frozenView());
+                double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+                cout << "Contraction hierarchy built in " << seconds * 1000 << " ms ("
+                     << hierarchy.shortcuts << " shortcuts).\n";
+                break;
+            }
+
+            case 11:
+            case 12: {
+                // Save or load the hierarchy
+                string path;
+                cout << "Enter file name: ";
+                cin >> path;
+                if (choice == 11) {
+                    cout << (hierarchy.save(path) ? "Contraction hierarchy saved.\n" : "Could not write the file.\n");
+                } else if (hierarchy.load(path)) {
+                    cout << "Contraction hierarchy loaded (" << hierarchy.numCities() << " cities).\n";
+                } else {
+                    cout << "Could not read a valid contraction hierarchy from the file.\n";
+                }
+                break;
+            }
+
+            case 13: {
+                // Cheapest cost through the hierarchy
+                int sourceIndex, destIndex;
+                cout << "Enter source city index (1-based): ";
+                cin >> sourceIndex;
+                cout << "Enter destination city index (1-based): ";
+                cin >> destIndex;
+                int numCities = hierarchy.numCities();
+                if (numCities == 0) {
+                    cout << "Build or load a contraction hierarchy first.\n";
+                } else if (sourceIndex < 1 || sourceIndex > numCities || destIndex < 1 || destIndex > numCities) {
+                    cout << "Invalid city index.\n";
+                } else {
+                    auto start = chrono::steady_clock::now();
+                    long long cost = hierarchy.query(sourceIndex - 1, destIndex - 1);
+                    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+                    if (cost == NO_ROUTE) cout << "No route between these cities.";
+                    else cout << "Cheapest cost: " << cost;
+                    cout << " (" << seconds * 1e6 << " us)\n";
+                }
+                break;
+            }
+
+            case 14: {
+                // Benchmark contraction hierarchies on a random network
+                int numCities, queries;
+                cout << "Enter number of cities (e.g. 200000): ";
+                cin >> numCities;
+                cout << "Enter number of queries (e.g. 1000): ";
+                cin >> queries;
+                if (numCities > 1 && queries > 0) {
+                    benchmarkContraction(numCities, queries);
+                }
+                break;
+            }
+
+            case 15: {
+                // Component ID of every city
+                vector<int> component = flightNetwork.connectedComponents(thread::hardware_concurrency());
+                cout << "\nNumber of components: " << flightNetwork.numComponents() << endl;
+                for (size_t i = 0; i < component.size(); i++) {
+                    cout << flightNetwork.cityName(i) << ": component " << component[i] + 1 << endl;
+                }
+                break;
+            }
+
+            case 16: {
+                // Benchmark component labeling on a random network
+                int numCities;
+                long long numFlights;
+                cout << "Enter number of cities (e.g. 1000000): ";
+                cin >> numCities;
+                cout << "Enter number of flights (e.g. 5000000): ";
+                cin >> numFlights;
+                if (numCities > 0 && numFlights >= 0) {
+                    benchmarkComponents(numCities, numFlights);
+                }
+                break;
+            }
+
+            case 17: {
+                // Cities reachable with at most k flights
+                int sourceIndex, hops;
+                flightNetwork.displayCities();
+                cout << "Enter source city index (1-based): ";
+                cin >> sourceIndex;
+                cout << "Enter maximum number of flights: ";
+                cin >> hops;
+                if (sourceIndex < 1 || sourceIndex > flightNetwork.numCities()) {
+                    cout << "Invalid city index.\n";
+                    break;
+                }
+                BfsResult bfs = flightNetwork.hopDistances(sourceIndex - 1, hops, thread::hardware_concurrency());
+                cout << "\nCities at most " << hops << " flights from " << flightNetwork.cityName(sourceIndex - 1) << ":\n";
+                for (size_t i = 0; i < bfs.hops.size(); i++) {
+                    if (bfs.hops[i] > 0) {
+                        cout << flightNetwork.cityName(i) << ": " << bfs.hops[i] << (bfs.hops[i] == 1 ? " flight\n" : " flights\n");
+                    }
+                }
+                if (bfs.reached == 1) cout << "None.\n";
+                break;
+            }
+
+            case 18: {
+                // Benchmark BFS on a random network
+                int numCities, sources;
+                long long numFlights;
+                cout << "Enter number of cities (e.g. 1000000): ";
+                cin >> numCities;
+                cout << "Enter number of flights (e.g. 8000000): ";
+                cin >> numFlights;
+                cout << "Enter number of source cities (e.g. 8): ";
+                cin >> sources;
+                if (numCities > 0 && numFlights > 0 && sources > 0) {
+                    benchmarkBfs(numCities, numFlights, sources);
+                }
+                break;
+            }
+
+            case 19: {
+                // Cities with a direct flight from both of two cities
+                int firstIndex, secondIndex;
+                flightNetwork.displayCities();
+                cout << "Enter first city index (1-based): ";
+                cin >> firstIndex;
+                cout << "Enter second city index (1-based): ";
+                cin >> secondIndex;
+                int numCities = flightNetwork.numCities();
+                if (firstIndex < 1 || firstIndex > numCities || secondIndex < 1 || secondIndex > numCities) {
+                    cout << "Invalid city index.\n";
+                    break;
+                }
+                vector<int> common = flightNetwork.commonNeighbors(firstIndex - 1, secondIndex - 1);
+                cout << "\nCities with flights from both " << flightNetwork.cityName(firstIndex - 1) << " and "
+                     << flightNetwork.cityName(secondIndex - 1) << " (" << (flightNetwork.usesMatrix() ? "matrix" : "list")
+                     << " storage):\n";
+                for (int c : common) cout << flightNetwork.cityName(c) << endl;
+                if (common.empty()) cout << "None.\n";
+                break;
+            }
+
+            case 20: {
+                // Benchmark list vs. matrix storage on a dense random network
+                int numCities, pairs;
+                double density;
+                cout << "Enter number of cities (e.g. 4000): ";
+                cin >> numCities;
+                cout << "Enter fraction of city pairs with a flight (e.g. 0.3): ";
+                cin >> density;
+                cout << "Enter number of common-neighbor queries (e.g. 100000): ";
+                cin >> pairs;
+                if (numCities > 0 && density >= 0 && pairs >= 0) {
+                    benchmarkMatrix(numCities, density, pairs);
+                }
+                break;
+            }
+
+            case 21:
+            case 22: {
+                // Save or load the whole network
+                string path;
+                cout << "Enter file name: ";
+                cin >> path;
+                if (choice == 21) {
+                    cout << (flightNetwork.saveSnapshot(path) ? "Network saved.\n" : "Could not write the file.\n");
+                } else if (flightNetwork.loadSnapshot(path)) {
+                    cout << "Network loaded (" << flightNetwork.numCities() << " cities, "
+                         << flightNetwork.flightEntries() / 2 << " flights).\n";
+                } else {
+                    cout << "Could not read a valid network snapshot from the file.\n";
+                }
+                break;
+            }
+
+            case 23: {
+                // Read "source destination [cost]" lines
+                string path, error;
+                cout << "Enter file name: ";
+                cin >> path;
+                if (flightNetwork.importEdgeList(path, error)) {
+                    cout << "Network imported (" << flightNetwork.numCities() << " cities, "
+                         << flightNetwork.flightEntries() / 2 << " flights).\n";
+                } else {
+                    cout << "Import failed: " << error << "\n";
+                }
+                break;
+            }
+
+            case 24: {
+                // Benchmark text import vs. snapshot loading
+                int numCities;
+                long long numFlights;
+                cout << "Enter number of cities (e.g. 1000000): ";
+                cin >> numCities;
+                cout << "Enter number of flights (e.g. 5000000): ";
+                cin >> numFlights;
+                if (numCities > 0 && numFlights > 0) {
+                    benchmarkSnapshot(numCities, numFlights);
+                }
+                break;
+            }
+
+            case 25: {
+                // Cheapest cost between every pair of cities, as a table
+                DistanceMatrix costs;
+                string error;
+                if (!flightNetwork.allPairsCosts(costs, thread::hardware_concurrency(), APSP_AUTO, error)) {
+                    cout << "Cannot compute all-pairs costs: " << error << "\n";
+                    break;
+                }
+                int numCities = flightNetwork.numCities();
+                cout << "\nCheapest costs (- = no route):\n";
+                for (int a = 0; a < numCities; a++) {
+                    cout << flightNetwork.cityName(a) << ":";
+                    for (int b = 0; b < numCities; b++) {
+                        if (costs.at(a, b) == APSP_UNREACHABLE) cout << " -";
+                        else cout << " " << costs.at(a, b);
+                    }
+                    cout << endl;
+                }
+                break;
+            }
+
+            case 26: {
+                // Benchmark all-pairs methods on a random network
+                int numCities, degree;
+                cout << "Enter number of cities (e.g. 2000): ";
+                cin >> numCities;
+                cout << "Enter average flights per city (e.g. 8): ";
+                cin >> degree;
+                if (numCities > 0 && degree >= 0) {
+                    benchmarkAllPairs(numCities, degree);
+                }
+                break;
+            }
+
+            case 27: {
                 // Exit
                 cout << "Exiting the program...\n";
                 break;
@@ -162,7 +2580,7 @@ int main() {
                 cout << "Invalid choice. Please try again.\n";
         }
 
-    } while (choice != 6);  // Loop until the user exits
+    } while (choice != 27);  // Loop until the user exits
 
     return 0;
 }
@@ -175,6 +2593,8 @@ OVERALL TIME & SPACE COMPLEXITY:
 
 -> Graph Class: Represents the flight network using a cities vector (a list of city names) and an adjList unordered map (the adjacency list). 
    The map connects city indices to the flight connections (edges).
+   Constructed with ADJ_MATRIX (or AUTO_STORAGE once the network is dense),
+   the flights are kept in a bit matrix plus a cost matrix instead.
   - A data structure consisting of nodes (vertices) and connections (edges).
   - Used to model relationships like cities and flights in this problem.
 
@@ -187,13 +2607,22 @@ OVERALL TIME & SPACE COMPLEXITY:
 
 4. Depth-First Search (DFS):
    - A graph traversal algorithm that explores as far as possible along a branch before backtracking.
-   - Used here to check if the graph is connected.
+   - Done with an explicit stack of pending cities rather than recursion,
+     so a long chain of cities cannot overflow the call stack.
    - Time Complexity: O(V + E)
-   - Space Complexity: O(V) for visited array and call stack
+   - Space Complexity: O(V) for visited array and stack
 
 5. Connectivity in Graph:
    - A graph is connected if there is a path between every pair of nodes.
-   - DFS from any node should visit all nodes in a connected graph.
+   - Union-find (disjoint sets) keeps one tree per group of connected
+     cities. addFlight unites the groups of its two cities, so the number
+     of groups is always known: isConnected is O(1) and "are a and b
+     connected?" is two finds, O(α(n)) with union by size and path halving.
+   - Component IDs for every city: either a BFS from each unlabeled city,
+     or a parallel union-find over all flights. The parallel version
+     links roots with compare-and-swap (always the larger root below the
+     smaller, so no cycles) and needs no locks; each thread handles the
+     flights of one block of cities.
 
 6. Edge (Flight):
    - Represents a connection between two cities with a cost (fuel/time).
@@ -216,8 +2645,118 @@ OVERALL TIME & SPACE COMPLEXITY:
     - A simple console interface that allows user interaction.
     - Offers options like adding flights, checking connectivity, etc.
 
+11. CSR (Compressed Sparse Row):
+   - freeze() copies the adjacency list into three flat arrays: offsets
+     (one per city + 1), destinations and costs (one per flight entry).
+   - The flights of city c are destinations[offsets[c] .. offsets[c+1]-1].
+   - A traversal step is an index into contiguous memory instead of a hash
+     lookup plus a pointer to a separately allocated vector, so the CPU can
+     prefetch and caches hold far more useful data.
+   - The copy is immutable: addFlight marks it stale and the next freeze()
+     rebuilds it in O(V + E). Two passes (count, then fill) avoid any
+     reallocation.
+   - Space: O(V + E), with no per-city allocation or hash table overhead.
+
+12. Shortest Paths:
+   - Dijkstra: repeatedly finalize the unfinished city with the smallest
+     known cost and relax its flights. Costs must be non-negative, so
+     addFlight, the edge-list importer and snapshot loading reject negative ones.
+   - The priority queue is a 4-ary heap with lazy deletion: a cheaper cost
+     is pushed as a new entry and stale entries are skipped when popped.
+     Time: O((V + E) log V).
+   - The cost/parent arrays are reused across queries and only the
+     entries a query touched are reset, so short queries stay cheap.
+   - Bidirectional Dijkstra searches from both ends and stops once the
+     two smallest frontier costs add up to at least the best meeting
+     route found; each side explores roughly a disk of half the radius.
+   - A* orders cities by cost so far + heuristic(city), a lower bound on
+     the remaining cost (here: straight-line distance), steering the search
+     towards the destination. With a consistent heuristic each city is
+     still finalized once and the result is optimal.
+   - The route is rebuilt by following parent links back from the target.
+
+13. Contraction Hierarchies:
+   - Preprocessing removes ("contracts") cities one at a time, least
+     important first. When city v is removed, each pair of its neighbors
+     u, w gets a shortcut u-w costing c(u,v) + c(v,w), unless a local
+     Dijkstra that avoids v finds a "witness" route no more expensive.
+   - Importance = shortcuts needed - flights removed + neighbors already
+     contracted, kept in a heap and re-evaluated lazily when popped.
+   - Each city keeps only its flights to cities contracted after it (more
+     important ones). On every cheapest route there is then a version that
+     only goes up in importance and then down.
+   - A query runs Dijkstra upward from both ends; the answer is the best
+     city reached from both. Each side only explores a few hundred cities,
+     instead of a large part of the network, so queries take microseconds.
+   - The hierarchy (rank, upward flights in CSR form) is saved to a binary
+     file ("FNCH", version 1) so preprocessing runs once per network
+     change; loading checks sizes and indices before using the data.
+   - Queries return the cost only; the route itself would need the
+     shortcuts to be unpacked into the flights they replace.
+
+14. Direction-Optimizing BFS:
+   - Breadth-first search visits cities level by level, so the level at
+     which a city is found is its number of flights from the source, and
+     stopping after k levels gives "everything within k flights".
+   - Top-down: each frontier city looks at all of its flights. Bottom-up:
+     each unvisited city looks for one neighbor in the frontier and stops
+     there. In the middle levels of a well-connected network the frontier
+     is huge and bottom-up checks far fewer flights; early and late levels
+     are small and top-down is cheaper. The search switches using the
+     flight counts of the frontier and of the unexplored part.
+   - The frontier and the visited set are bitmaps (one bit per city), so
+     threads can split a level by 64-city words and "is it in the frontier"
+     is one bit test.
+   - Speed is reported as traversed edges per second (TEPS), the Graph500
+     measure: flights in the reached part of the network / search time.
+
+15. Adjacency Matrix (bit-packed):
+   - Row a has one bit per city, set when a flight a-b exists; rows are
+     padded to whole 64-bit words. Costs live in a separate n x n int
+     matrix (the cheapest flight if a pair has several).
+   - Neighbors of a city: scan its row, skipping 64 empty cities per zero
+     word. Common neighbors of a and b: AND the two rows. Transitive
+     closure (Warshall): for every k, OR row k into each row containing
+     k, one word at a time, O(V^3 / 64).
+   - Space Complexity: O(V^2), about 4.1 bytes per city pair.
+   - AUTO_STORAGE starts as a list and moves to the matrix once a quarter
+     of all city pairs are linked, where the two cost about the same
+     memory; setCities re-checks the density.
+
+16. Snapshot Files and mmap:
+   - A snapshot ("FNGR", version 2) is the CSR arrays plus a city name
+     table written back to back, each array 8-byte aligned (padding after
+     the destinations if their count is odd). Loading maps
+     the file into memory and points the CSR arrays at it: no parsing and
+     no copying, the OS reads pages in as they are first used.
+   - Loading still checks the header, the file size, that offsets never
+     decrease, that every destination is a valid city and that no cost is
+     negative, in one pass.
+   - A loaded network lives only in the CSR arrays. The first addFlight or
+     setCities copies the flights into the list (or matrix); the
+     union-find is built the first time connectivity is asked for.
+   - The edge-list importer reads the text in 1 MB blocks, parses numbers
+     by hand (no stream extraction per number) and builds the CSR arrays
+     with a counting sort by city, O(V + E). The network is sized from the
+     largest id, so ids more than 2E + 2^20 are rejected rather than
+     allocating billions of empty cities.
+
+17. All-Pairs Cheapest Costs:
+   - Floyd-Warshall: for every city k, d[i][j] = min(d[i][j], d[i][k] +
+     d[k][j]). O(V^3) time whatever the number of flights, O(V^2) space.
+   - Tiled: the matrix is cut into 64 x 64 tiles. For each diagonal tile,
+     update it, then its row and column of tiles, then all other tiles;
+     those last updates are independent (so they run on all threads) and
+     each only touches three tiles that fit in cache.
+   - The inner step is a min-plus product: add a row of b to one value of
+     a, take the minimum with a row of c. With AVX2 that is 8 ints per
+     instruction; the result is stored as 32-bit ints (4 bytes per pair).
+   - Sparse networks: one Dijkstra per city, O(V (E + V log V)), with the
+     source cities split between threads (each with its own search state).
+
 Justification for Adjacency List:
 
 The adjacency list is space-efficient, especially when the number of flight paths is much smaller than the number of cities. 
 This means it uses less memory compared to the adjacency matrix, which would use O(n^2) space even if most cities are not directly connected.
+The matrix is only worth it for dense networks, which is why the menu's network uses AUTO_STORAGE.
 */
@@ -3,7 +3,11 @@
 #include <iostream>      // For input/output operations
 #include <vector>        // For using vectors for storing edges and adjacency list
 #include <cstdint>       // For using fixed width integers like INT32_MAX
-#define MAX_NUM_CITIES 10  // Maximum cities (vertices) that can be input
+#include <algorithm>     // For sorting edges in Kruskal's algorithm
+#include <chrono>        // For timing the benchmark
+#include <random>        // For generating benchmark networks
+#include <fstream>       // For reading a network from a file
+#include <string>        // For city names
 
 using namespace std;
 
@@ -14,144 +18,488 @@ struct edge {
     int wt;     // Cost or weight of the connection (edge)
 };
 
+// Neighbors of every city stored back to back (compressed sparse row):
+// the connections of city c are at positions [offsets[c], offsets[c + 1])
+struct adjacency {
+    vector<int> offsets;   // Start of each city's connections (city_count + 1 entries)
+    vector<int> to;        // Other city of each connection
+    vector<int> wt;        // Cost of each connection
+};
+
+// Build the adjacency of an undirected graph from its list of edges
+adjacency build_adjacency(int city_count, const vector<edge> &edges) {
+    adjacency adj;
+    adj.offsets.assign(city_count + 1, 0);
+    for (const edge &e : edges) {            // Count connections per city
+        adj.offsets[e.start + 1]++;
+        adj.offsets[e.end + 1]++;
+    }
+    for (int c = 0; c < city_count; c++) adj.offsets[c + 1] += adj.offsets[c];
+    adj.to.resize(2 * edges.size());
+    adj.wt.resize(2 * edges.size());
+    vector<int> next(adj.offsets.begin(), adj.offsets.end() - 1);
+    for (const edge &e : edges) {            // Store each edge in both directions
+        adj.to[next[e.start]] = e.end;
+        adj.wt[next[e.start]++] = e.wt;
+        adj.to[next[e.end]] = e.start;
+        adj.wt[next[e.end]++] = e.wt;
+    }
+    return adj;
+}
+
+// Binary min-heap of cities keyed by cost, with the position of every city
+// in the heap remembered so its key can be lowered in place (decrease-key)
+// instead of pushing a duplicate entry
+struct indexed_heap {
+    vector<int> heap;      // Cities in heap order
+    vector<int> pos;       // Index of each city in `heap`, -1 if not in it
+    vector<int> key;       // Current key of each city
+
+    indexed_heap(int city_count) : pos(city_count, -1), key(city_count, INT32_MAX) {}
+
+    bool empty() const { return heap.empty(); }
+
+    // Insert city with key k, or lower its key to k if it is already queued
+    void push_or_decrease(int city, int k) {
+        if (pos[city] == -1) {
+            pos[city] = heap.size();
+            heap.push_back(city);
+        } else if (k >= key[city]) {
+            return;
+        }
+        key[city] = k;
+        sift_up(pos[city]);
+    }
+
+    // Remove and return the city with the smallest key
+    int pop_min() {
+        int top = heap[0];
+        pos[top] = -1;
+        int last = heap.back();
+        heap.pop_back();
+        if (!heap.empty()) {
+            heap[0] = last;
+            pos[last] = 0;
+            sift_down(0);
+        }
+        return top;
+    }
+
+    void sift_up(int i) {
+        int city = heap[i];
+        while (i > 0) {
+            int parent = (i - 1) / 2;
+            if (key[heap[parent]] <= key[city]) break;
+            heap[i] = heap[parent];
+            pos[heap[i]] = i;
+            i = parent;
+        }
+        heap[i] = city;
+        pos[city] = i;
+    }
+
+    void sift_down(int i) {
+        int city = heap[i], n = heap.size();
+        while (true) {
+            int child = 2 * i + 1;
+            if (child >= n) break;
+            if (child + 1 < n && key[heap[child + 1]] < key[heap[child]]) child++;
+            if (key[heap[child]] >= key[city]) break;
+            heap[i] = heap[child];
+            pos[heap[i]] = i;
+            i = child;
+        }
+        heap[i] = city;
+        pos[city] = i;
+    }
+};
+
+// Disjoint sets of cities (union-find) with union by size and path halving
+struct union_find {
+    vector<int> parent;
+    vector<int> size;
+
+    union_find(int city_count) : parent(city_count), size(city_count, 1) {
+        for (int i = 0; i < city_count; i++) parent[i] = i;
+    }
+
+    int find(int x) {
+        while (parent[x] != x) {
+            parent[x] = parent[parent[x]];   // Path halving: skip every other link
+            x = parent[x];
+        }
+        return x;
+    }
+
+    // Merge the sets of a and b; false if they were already the same set
+    bool unite(int a, int b) {
+        a = find(a);
+        b = find(b);
+        if (a == b) return false;
+        if (size[a] < size[b]) swap(a, b);
+        parent[b] = a;
+        size[a] += size[b];
+        return true;
+    }
+};
+
+// Prim's algorithm with an indexed heap: the heap holds every city next to
+// the tree, keyed by its cheapest connection to the tree. Each city is
+// popped once and each connection may lower a key once: O(E log V).
+// Appends the tree edges (start = city already in the tree) and returns
+// their total cost. Cities the start cannot reach are grown from in turn,
+// so on a disconnected graph this is a spanning forest, as with Kruskal.
+long long prim_heap(const adjacency &adj, int start, vector<edge> &tree) {
+    int city_count = adj.offsets.size() - 1;
+    vector<bool> in_tree(city_count, false);
+    vector<int> via(city_count, -1);          // Tree city at the other end of the cheapest connection
+    indexed_heap frontier(city_count);
+    long long total = 0;
+    for (int c = -1; c < city_count; c++) {   // The start city first, then every city left out
+        int root = (c == -1) ? start : c;
+        if (in_tree[root]) continue;
+        frontier.push_or_decrease(root, 0);
+        while (!frontier.empty()) {
+            int u = frontier.pop_min();
+            in_tree[u] = true;
+            if (via[u] != -1) {
+                edge e;
+                e.start = via[u];
+                e.end = u;
+                e.wt = frontier.key[u];
+                tree.push_back(e);
+                total += e.wt;
+            }
+            for (int i = adj.offsets[u]; i < adj.offsets[u + 1]; i++) {
+                int v = adj.to[i];
+                if (!in_tree[v] && adj.wt[i] < frontier.key[v]) {
+                    via[v] = u;
+                    frontier.push_or_decrease(v, adj.wt[i]);
+                }
+            }
+        }
+    }
+    return total;
+}
+
+// Kruskal's algorithm: take the edges cheapest first and keep each one
+// that joins two different groups of cities (union-find). O(E log E) for
+// the sort. Appends the tree edges and returns their total cost; on a
+// disconnected graph this is a spanning forest.
+long long kruskal(int city_count, vector<edge> edges, vector<edge> &tree) {
+    sort(edges.begin(), edges.end(), [](const edge &a, const edge &b) { return a.wt < b.wt; });
+    union_find groups(city_count);
+    long long total = 0;
+    for (const edge &e : edges) {
+        if ((int)tree.size() == city_count - 1) break;   // Tree complete
+        if (groups.unite(e.start, e.end)) {
+            tree.push_back(e);
+            total += e.wt;
+        }
+    }
+    return total;
+}
+
+// Most entries read() reserves ahead: the counts come from the input, and
+// a bogus one must not allocate more than the entries actually present
+const int READ_RESERVE = 1 << 20;
+
 class graph {
-    int adj_mat[MAX_NUM_CITIES][MAX_NUM_CITIES] = {0}; // Adjacency matrix for graph, holds cost between cities
-    string city_names[MAX_NUM_CITIES];                 // Array of city names
+    vector<string> city_names;                         // Name of each city (index = city code)
     int city_count;                                    // Total number of cities
-    edge mst[MAX_NUM_CITIES - 1];                      // Stores the edges in the MST
-    void add_to_list(vector<edge> &, edge);            // Helper function to insert edge into sorted vector
-    int cost;                                          // Total cost of MST
+    vector<edge> edges;                                // Every connection once: memory grows with connections, not cities^2
+    vector<edge> mst;                                  // Stores the edges in the MST
+    long long cost;                                    // Total cost of MST
+    void store_mst(const vector<edge> &, long long);   // Helper function to keep a result as mst/cost
 
    public:
-    graph();                 // Constructor to initialize the graph
-    void prims_algo(int);    // Function to build MST using Prim's algorithm
-    void display_mst();      // Display the MST and its total cost
+    graph();                         // Constructor to create an empty graph
+    bool read(istream &, bool);      // Read cities and connections from a stream
+    int cities() const { return city_count; }
+    size_t connections() const { return edges.size(); }
+    void prims_algo(int);            // Function to build MST using Prim's algorithm
+    void kruskals_algo();            // Function to build MST using Kruskal's algorithm
+    void display_mst();              // Display the MST and its total cost
 };
 
-// Helper function to add edge into the vector `list` sorted by weight (min first)
-void graph::add_to_list(vector<edge> &list, edge e) {
-    list.push_back(e);
-    // Bubble it to correct position to keep list sorted
-    for (int i = list.size() - 1; i > 0; i--) {
-        if (list[i].wt < list[i - 1].wt) {
-            swap(list[i], list[i - 1]);
-        } else {
-            break;
-        }
-    }
+// Helper function to store a computed tree as the current MST
+void graph::store_mst(const vector<edge> &tree, long long total) {
+    mst = tree;
+    cost = total;
 }
 
-// Constructor: Initializes graph with cities and connections
+// Constructor: starts with no cities; read() fills the graph in
 graph::graph() {
     cost = 0;  // Start with 0 cost
-    cout << "Number of cities are (1-" << MAX_NUM_CITIES << "):\t";
-    cin >> city_count;
-    // Clamp to max limit if exceeded
-    city_count = (city_count > MAX_NUM_CITIES) ? MAX_NUM_CITIES : city_count;
+    city_count = 0;
+}
 
-    // Input city names
-    for (int i = 0; i < city_count; i++) {
-        cout << "Enter city:\n" << i + 1 << ":\t";
-        cin >> city_names[i];
+// Function to read the graph from a stream, in the order the questions
+// are asked: number of cities, the city names (one word each), number of
+// pairs, then "x y cost" for every pair (city codes from 0). With prompts
+// on, each value is asked for (keyboard input); with prompts off the same
+// values are read silently (a file). Returns false, with a message, on
+// input that ends early (including a count larger than the entries that
+// follow) or names a city code that does not exist.
+bool graph::read(istream &in, bool prompts) {
+    if (prompts) cout << "Number of cities are:\t";
+    if (!(in >> city_count) || city_count < 1) {
+        cout << "Invalid number of cities." << endl;
+        return false;
     }
 
-    // Initialize adjacency matrix with high value (no path)
-    for (int i = 0; i < city_count; i++)
-        for (int j = 0; j < city_count; j++) 
-            adj_mat[i][j] = INT32_MAX;
+    // Input city names; the vector grows with the names actually read
+    city_names.clear();
+    city_names.reserve(min(city_count, READ_RESERVE));
+    string name;
+    for (int i = 0; i < city_count; i++) {
+        if (prompts) cout << "Enter city:\n" << i + 1 << ":\t";
+        if (!(in >> name)) {
+            cout << "Input ended before city " << i + 1 << "." << endl;
+            return false;
+        }
+        city_names.push_back(name);
+    }
 
-    int num_pairs;
-    cout << "Number of city pairs are:\t";
-    cin >> num_pairs;
+    long long num_pairs;
+    if (prompts) cout << "Number of city pairs are:\t";
+    if (!(in >> num_pairs) || num_pairs < 0) {
+        cout << "Invalid number of city pairs." << endl;
+        return false;
+    }
 
     // Show city index (used as vertex ID) and name
-    cout << "City codes are:\t" << endl;
-    for (int i = 0; i < city_count; i++) {
-        cout << i << " - " << city_names[i] << endl;
+    if (prompts) {
+        cout << "City codes are:\t" << endl;
+        for (int i = 0; i < city_count; i++) {
+            cout << i << " - " << city_names[i] << endl;
+        }
     }
 
-    // Input the connections (edges) between city pairs
+    // Input the connections (edges) between city pairs; a pair given twice
+    // keeps both entries and the MST simply uses the cheaper one
+    edges.clear();
+    edges.reserve(min<long long>(num_pairs, READ_RESERVE));
     int x, y, wt;
-    for (int i = 0; i < num_pairs; i++) {
-        cout << "Enter pair:\n" << i + 1 << ":\t";
-        cin >> x >> y;
-        cout << "Enter cost between city " << city_names[x] << " & city " << city_names[y] << ":\t";
-        cin >> wt;
-        adj_mat[x][y] = wt;  // Set cost in both directions since it's undirected
-        adj_mat[y][x] = wt;
+    for (long long i = 0; i < num_pairs; i++) {
+        if (prompts) cout << "Enter pair:\n" << i + 1 << ":\t";
+        if (!(in >> x >> y)) {
+            cout << "Input ended before pair " << i + 1 << "." << endl;
+            return false;
+        }
+        if (x < 0 || y < 0 || x >= city_count || y >= city_count) {
+            cout << "Pair " << i + 1 << ": no city with code " << (x < 0 || x >= city_count ? x : y) << "." << endl;
+            return false;
+        }
+        if (prompts) cout << "Enter cost between city " << city_names[x] << " & city " << city_names[y] << ":\t";
+        if (!(in >> wt)) {
+            cout << "Input ended before the cost of pair " << i + 1 << "." << endl;
+            return false;
+        }
+        edge e;
+        e.start = x;
+        e.end = y;
+        e.wt = wt;
+        edges.push_back(e);  // Stored once; build_adjacency adds both directions
     }
+    mst.clear();
+    cost = 0;
+    return true;
 }
 
-// Function to implement Prim's algorithm
+// Function to implement Prim's algorithm (indexed heap, see prim_heap)
 void graph::prims_algo(int start) {
-    bool visited[MAX_NUM_CITIES] = {0};  // Track visited cities
-    int visited_count = 1;               // Number of cities included in MST
-    visited[start] = 1;                  // Mark start city as visited
-
-    vector<edge> adj;                    // Candidate edges to explore
-
-    // Add all edges from the starting city to the list
-    for (int i = 0; i < city_count; i++) {
-        if (adj_mat[start][i] != INT32_MAX) {
-            edge e;
-            e.start = start;
-            e.end = i;
-            e.wt = adj_mat[start][i];
-            add_to_list(adj, e);         // Add edge to list sorted by weight
-        }
-    }
-
-    // Loop until all cities are included in the MST
-    while (visited_count != city_count) {
-        edge m = adj.front();       // Pick minimum weight edge
-        adj.erase(adj.begin());     // Remove it from list
-
-        if (!visited[m.end]) {      // If destination city is not visited
-            mst[visited_count - 1] = m;  // Add edge to MST
-            cost += m.wt;                // Add cost to total MST cost
-
-            // Explore all edges from newly added city
-            for (int i = 0; i < city_count; i++) {
-                if (adj_mat[m.end][i] != INT32_MAX) {
-                    edge e;
-                    e.start = m.end;
-                    e.end = i;
-                    e.wt = adj_mat[e.start][i];
-                    add_to_list(adj, e);   // Add to candidate edges
-                }
-            }
+    vector<edge> tree;
+    long long total = prim_heap(build_adjacency(city_count, edges), start, tree);
+    store_mst(tree, total);
+}
 
-            visited[m.end] = 1;   // Mark as visited
-            visited_count++;      // Increment number of cities added
-        }
-    }
+// Function to implement Kruskal's algorithm (union-find, see kruskal)
+void graph::kruskals_algo() {
+    vector<edge> tree;
+    long long total = kruskal(city_count, edges, tree);
+    store_mst(tree, total);
 }
 
 // Function to display the resulting Minimum Spanning Tree
 void graph::display_mst() {
     cout << "Most efficient network is:\t" << endl;
 
-    for (int i = 0; i < city_count - 1; i++) {
+    for (size_t i = 0; i < mst.size(); i++) {
         // Show edge between city names with cost
         cout << city_names[mst[i].start] << " to " << city_names[mst[i].end]
              << " of weight " << mst[i].wt << endl;
     }
+    if ((int)mst.size() < city_count - 1) {
+        cout << "Not every city can be reached: each group of connected cities gets its own cheapest network." << endl;
+    }
 
     // Total cost of building the network
     cout << endl << "The cost of network is:\t" << cost << endl;
 }
 
+// The previous Prim's frontier, kept for comparison: candidate edges in a
+// vector kept sorted by insertion (bubbling the new edge into place) and
+// the minimum removed from the front, so every step is O(E): O(E^2) total.
+// Grows from every unreached city too, giving the same forest as prim_heap.
+long long prim_sorted_vector(const adjacency &adj, int start, vector<edge> &tree) {
+    int city_count = adj.offsets.size() - 1;
+    vector<bool> visited(city_count, false);
+    vector<edge> list;
+    long long total = 0;
+    auto add_edges = [&](int u) {
+        for (int i = adj.offsets[u]; i < adj.offsets[u + 1]; i++) {
+            edge e;
+            e.start = u;
+            e.end = adj.to[i];
+            e.wt = adj.wt[i];
+            list.push_back(e);
+            for (int j = list.size() - 1; j > 0 && list[j].wt < list[j - 1].wt; j--) swap(list[j], list[j - 1]);
+        }
+    };
+    for (int c = -1; c < city_count; c++) {   // The start city first, then every city left out
+        int root = (c == -1) ? start : c;
+        if (visited[root]) continue;
+        visited[root] = true;
+        add_edges(root);
+        while (!list.empty()) {
+            edge m = list.front();
+            list.erase(list.begin());
+            if (visited[m.end]) continue;
+            tree.push_back(m);
+            total += m.wt;
+            visited[m.end] = true;
+            add_edges(m.end);
+        }
+    }
+    return total;
+}
+
+// Random network in `groups` separate groups of consecutive city codes:
+// a random tree inside each group, then random connections inside the
+// groups until there are edge_count of them
+vector<edge> random_network(int city_count, long long edge_count, int groups, mt19937 &rng) {
+    auto group_of = [&](int c) { return (int)((long long)c * groups / city_count); };
+    auto group_begin = [&](int g) { return (int)(((long long)g * city_count + groups - 1) / groups); };
+    vector<edge> edges;
+    edges.reserve(max<long long>(edge_count, city_count - groups));
+    for (int c = 0; c < city_count; c++) {                // Random tree per group
+        int first = group_begin(group_of(c));
+        if (c == first) continue;
+        edge e;
+        e.start = first + rng() % (c - first);
+        e.end = c;
+        e.wt = 1 + rng() % 1000000;
+        edges.push_back(e);
+    }
+    while ((long long)edges.size() < edge_count) {
+        edge e;
+        e.start = rng() % city_count;
+        int g = group_of(e.start), first = group_begin(g);
+        e.end = first + rng() % (group_begin(g + 1) - first);
+        e.wt = 1 + rng() % 1000000;
+        if (e.start != e.end) edges.push_back(e);
+    }
+    return edges;
+}
+
+// Benchmark: heap Prim vs. Kruskal (and the sorted-vector Prim on small
+// inputs) on a random connected network, then on one split into two
+// groups, where both must return the same spanning forest
+void benchmark_mst(int city_count, long long edge_count) {
+    if (city_count < 2 && edge_count > 0) {             // Only self-loops possible: the filler would never stop
+        cout << "Connections need at least 2 cities." << endl;
+        return;
+    }
+    mt19937 rng(49);
+    for (int groups = 1; groups <= 2; groups++) {
+        if (groups == 2 && city_count < 4) break;       // Each group needs 2 cities for its connections
+        vector<edge> edges = random_network(city_count, edge_count, groups, rng);
+        cout << (groups == 1 ? "Connected" : "Disconnected (2 groups)") << " - cities: " << city_count
+             << ", connections: " << edges.size() << endl;
+
+        auto start = chrono::steady_clock::now();
+        adjacency adj = build_adjacency(city_count, edges);
+        double adj_time = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+        vector<edge> tree;
+        start = chrono::steady_clock::now();
+        long long prim_cost = prim_heap(adj, 0, tree);
+        double prim_time = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        size_t prim_edges = tree.size();
+
+        tree.clear();
+        start = chrono::steady_clock::now();
+        long long kruskal_cost = kruskal(city_count, edges, tree);
+        double kruskal_time = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+        cout << "  Prim (indexed heap): " << prim_time * 1000 << " ms (+ " << adj_time * 1000
+             << " ms building the adjacency), cost " << prim_cost << ", " << prim_edges << " edges" << endl;
+        cout << "  Kruskal (union-find): " << kruskal_time * 1000 << " ms, cost " << kruskal_cost
+             << ", " << tree.size() << " edges"
+             << (kruskal_cost == prim_cost && tree.size() == prim_edges ? "" : " (RESULTS DIFFER)") << endl;
+        if (edges.size() <= 20000) {
+            tree.clear();
+            start = chrono::steady_clock::now();
+            long long old_cost = prim_sorted_vector(adj, 0, tree);
+            double old_time = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+            cout << "  Prim (sorted vector): " << old_time * 1000 << " ms, cost " << old_cost
+                 << (old_cost == prim_cost ? "" : " (COSTS DIFFER)") << endl;
+        } else {
+            cout << "  Prim (sorted vector): skipped, O(E^2) above 20000 connections" << endl;
+        }
+    }
+}
+
 int main() {
+    int mode;
+    cout << "1. Enter offices and find the most efficient network\n2. Benchmark MST algorithms\n"
+            "3. Read offices from a file and find the most efficient network\nChoice:\t";
+    cin >> mode;
+    if (mode == 2) {
+        int city_count;
+        long long edge_count;
+        cout << "Number of cities (e.g. 1000000):\t";
+        cin >> city_count;
+        cout << "Number of connections (e.g. 5000000):\t";
+        cin >> edge_count;
+        if (city_count > 0 && edge_count >= 0) benchmark_mst(city_count, edge_count);
+        return 0;
+    }
+
     // Initialize graph and input
     graph g;
+    if (mode == 3) {
+        string path;
+        cout << "File name:\t";
+        cin >> path;
+        ifstream file(path);
+        if (!file) {
+            cout << "Cannot open " << path << "." << endl;
+            return 1;
+        }
+        auto start = chrono::steady_clock::now();
+        if (!g.read(file, false)) return 1;
+        double t = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        cout << "Read " << g.cities() << " cities and " << g.connections() << " pairs in " << t * 1000 << " ms" << endl;
+    } else if (!g.read(cin, true)) {
+        return 1;
+    }
 
-    int start;
-    cout << "Enter beginning city (city code 0-" << MAX_NUM_CITIES - 1 << "):\t";
-    cin >> start;
-    start = (start > MAX_NUM_CITIES - 1) ? 0 : start;  // Ensure valid input
-
-    // Build MST and display result
-    g.prims_algo(start);
+    int algorithm;
+    cout << "Algorithm (1 - Prim, 2 - Kruskal):\t";
+    cin >> algorithm;
+    if (algorithm == 2) {
+        g.kruskals_algo();
+    } else {
+        int start;
+        cout << "Enter beginning city (city code 0-" << g.cities() - 1 << "):\t";
+        cin >> start;
+        start = (start < 0 || start > g.cities() - 1) ? 0 : start;  // Ensure valid input
+
+        // Build MST with Prim's algorithm
+        g.prims_algo(start);
+    }
     g.display_mst();
 
     return 0;
@@ -168,10 +516,14 @@ THEORY OF CONCEPTS USED:
    - A data structure with vertices (cities) and edges (phone lines).
    - Can be represented as adjacency matrix or adjacency list.
 
-2. Adjacency Matrix:
-   - 2D array where adj[i][j] = cost of edge from city i to j.
-   - If no direct edge, use a large value like INT32_MAX.
-   - Space Complexity: O(V^2), where V = number of cities.
+2. Edge list and adjacency (CSR):
+   - The graph keeps every connection once in a vector<edge>, so memory
+     grows with the number of connections E, not with V^2 as an adjacency
+     matrix would (200k offices would need 160 GB as an int matrix).
+   - Prim's algorithm needs the neighbors of each city: build_adjacency
+     turns the edge list into flat arrays (offsets/to/wt), each edge stored
+     in both directions, in O(V + E).
+   - Space Complexity: O(V + E), where V = number of cities.
 
 3. Minimum Spanning Tree (MST):
    - A subset of edges that connects all vertices with minimum total cost and no cycles.
@@ -180,33 +532,55 @@ THEORY OF CONCEPTS USED:
 4. Prim’s Algorithm:
    - Greedy algorithm for finding MST.
    - Starts from any vertex and keeps adding the smallest edge that connects to an unvisited vertex.
+   - When the heap runs empty with cities left over, the graph is disconnected:
+     Prim starts again from the next unvisited city, so like Kruskal it
+     returns a minimum spanning forest (one tree per group of cities).
    - Time Complexity: 
      - O(V^2) with adjacency matrix
-     - O(E log V) with min-heap (not used here)
+     - O(E log V) with min-heap (used here, see indexed heap below)
    - Space Complexity: O(V + E)
 
 5. edge structure:
    - Holds start city, end city, and weight (cost) of connection.
 
-6. vector<edge>:
-   - Dynamic array used to hold edges to explore (adjacent to current MST).
-
-7. Sorting (add_to_list function):
-   - Used to keep the edge list sorted by weight.
-   - Simple insertion method (bubble) to maintain increasing order.
-
-8. visited array:
-   - Boolean array to keep track of which cities are already connected to the MST.
-
-9. city_names array:
+6. Indexed heap (indexed_heap):
+   - Binary min-heap of the cities next to the tree, keyed by their
+     cheapest connection to it. pos[city] records where each city sits in
+     the heap, so a cheaper connection lowers the key in place
+     (decrease-key, O(log V)) instead of adding another entry.
+   - Replaces the earlier vector kept sorted by bubbling in each new edge
+     and erasing the front: O(E) per step, O(E^2) in total.
+
+7. Kruskal's Algorithm and union-find:
+   - Sort all edges by cost; keep an edge if its two cities are still in
+     different groups. The groups are disjoint sets (union_find) with union
+     by size and path halving, so each check is almost O(1).
+   - Time Complexity: O(E log E) for the sort.
+   - Gives the same total cost as Prim (the edges can differ when costs tie).
+
+8. in_tree vector:
+   - Boolean vector to keep track of which cities are already connected to the MST.
+
+9. city_names vector:
    - Holds the names of the cities to match city codes with names for display.
+   - Sized from the input, so there is no fixed maximum number of cities.
 
 10. MST storage:
-    - `mst` array stores final selected edges in MST.
-    - `cost` keeps the total cost of building the network.
+    - `mst` vector stores final selected edges in MST.
+    - `cost` keeps the total cost of building the network (long long: the
+      sum of many connection costs can exceed an int).
+
+11. Input:
+    - read() takes any input stream: the keyboard (with prompts) or a file
+      with the same values in the same order, without prompts.
+    - The counts are only trusted up to 2^20 entries for reserving memory;
+      past that the vectors grow as entries arrive, so a wrong count ends
+      with "Input ended before ..." instead of a failed huge allocation.
 
 WHY USE PRIM’S ALGORITHM:
 - Efficient for dense graphs (like office networks where many cities can be connected).
+- Kruskal only needs the list of edges and is usually faster on sparse graphs,
+  since sorting an array is cheaper than the heap's scattered accesses.
 - Always gives the optimal (minimum cost) result if edge weights are non-negative.
 
 REAL-LIFE USE:
@@ -1,7 +1,12 @@
 #include <iostream>
 #include <string>
+#include <vector>                // For benchmark key lists
+#include <chrono>                // For timing the benchmark
+#include "dictionary_stats.h"   // Shared comparison/latency instrumentation
 using namespace std;
 
+DictionaryStats dictStats;      // Instrumentation for this dictionary
+
 // Node structure for AVL Tree
 struct Node {
     string key;          // keyword
@@ -38,6 +43,7 @@ int getBalance(Node* n) {
 
 // Right rotation
 Node* rightRotate(Node* y) {
+    dictStats.rotations++;
     Node* x = y->left;
     Node* T2 = x->right;
 
@@ -54,6 +60,7 @@ Node* rightRotate(Node* y) {
 
 // Left rotation
 Node* leftRotate(Node* x) {
+    dictStats.rotations++;
     Node* y = x->right;
     Node* T2 = y->left;
 
@@ -72,6 +79,7 @@ Node* leftRotate(Node* x) {
 Node* insert(Node* node, string key, string meaning) {
     if (!node) return createNode(key, meaning); // Base case
 
+    dictStats.comparisons++;
     if (key < node->key)
         node->left = insert(node->left, key, meaning);  // Go left
     else if (key > node->key)
@@ -117,6 +125,7 @@ Node* deleteNode(Node* root, string key) {
     if (!root) return root;
 
     // Perform standard BST delete
+    dictStats.comparisons++;
     if (key < root->key)
         root->left = deleteNode(root->left, key);
     else if (key > root->key)
@@ -187,22 +196,81 @@ void displayDescending(Node* root) {
     }
 }
 
+// Locate a keyword without printing (counts comparisons)
+Node* findNode(Node* root, const string& key, int& comparisons) {
+    while (root) {
+        comparisons++; // Increment comparison count
+        dictStats.comparisons++;
+        if (key == root->key) return root;
+        root = (key < root->key) ? root->left : root->right;
+    }
+    return nullptr;
+}
+
 // Search for a keyword and count comparisons
 void search(Node* root, string key, int& comparisons) {
-    if (!root) {
+    OpTimer timer(dictStats);
+    Node* found = findNode(root, key, comparisons);
+    timer.finish(OP_SEARCH, [&] { return height(root); });
+
+    if (!found) {
         cout << "Keyword not found.\n";
         return;
     }
-    comparisons++; // Increment comparison count
-
-    if (key == root->key) {
-        cout << "Meaning: " << root->meaning << endl;
-        cout << "Comparisons: " << comparisons << endl;
-    } else if (key < root->key) {
-        search(root->left, key, comparisons);
-    } else {
-        search(root->right, key, comparisons);
+    cout << "Meaning: " << found->meaning << endl;
+    cout << "Comparisons: " << comparisons << endl;
+}
+
+// Free every node of the tree
+void destroyTree(Node* root) {
+    if (!root) return;
+    destroyTree(root->left);
+    destroyTree(root->right);
+    delete root;
+}
+
+// Count bytes used by the tree (nodes plus string heap storage)
+size_t treeMemory(Node* root) {
+    if (!root) return 0;
+    return sizeof(Node) + stringHeapBytes(root->key) + stringHeapBytes(root->meaning) +
+           treeMemory(root->left) + treeMemory(root->right);
+}
+
+// Benchmark: build the tree on n generated keywords and time n uniform and
+// n Zipfian lookups. Uses the same workloads as the BST dictionary's
+// benchmark (dictionary_stats.h), so the numbers are directly comparable.
+void benchmark(int n, bool terms) {
+    typedef chrono::steady_clock clock;
+    auto ms = [](clock::duration d) { return chrono::duration<double, milli>(d).count(); };
+    uint64_t savedRotations = dictStats.rotations;   // Keep benchmark out of the statistics
+    vector<string> keys(n);
+    for (int i = 0; i < n; i++) keys[i] = terms ? benchmarkTerm(i) : benchmarkKey(i);
+
+    Node* tree = nullptr;
+    auto t0 = clock::now();
+    for (int i = 0; i < n; i++) tree = insert(tree, keys[i], "m");
+    cout << "Keys: " << n << (terms ? " prefix-sharing terms" : " random words")
+         << ", insert: " << ms(clock::now() - t0) << " ms, height: " << height(tree)
+         << ", rotations: " << dictStats.rotations - savedRotations << ", "
+         << (double)treeMemory(tree) / n << " bytes/key\n";
+
+    for (int w = 0; w < 2; w++) {
+        vector<int> lookups = benchmarkLookups(n, n, w == 1);
+        long long comps = 0, found = 0;
+        auto s = clock::now();
+        for (int k : lookups) {
+            int c = 0;
+            found += findNode(tree, keys[k], c) != nullptr;
+            comps += c;
+        }
+        double time = ms(clock::now() - s);
+        cout << (w == 0 ? "Uniform" : "Zipfian (s = 1)") << " lookups (found " << found << " of " << n
+             << "): " << time * 1e6 / n << " ns/lookup, " << (double)comps / n << " comparisons/lookup\n";
     }
+
+    destroyTree(tree);
+    dictStats.rotations = savedRotations;
+    dictStats.comparisons = 0;
 }
 
 // Main function - menu driven
@@ -210,6 +278,8 @@ int main() {
     Node* root = nullptr;
     int choice;
     string key, meaning;
+    dictStats.structure = "AVL";
+    auto treeHeight = [&] { return height(root); }; // O(1): stored in the root
 
     do {
         cout << "\n--- AVL Tree Dictionary ---\n";
@@ -218,7 +288,9 @@ int main() {
         cout << "3. Display Ascending\n";
         cout << "4. Display Descending\n";
         cout << "5. Search Keyword\n";
-        cout << "6. Exit\n";
+        cout << "6. Show/Export Statistics (JSON)\n";
+        cout << "7. Benchmark (uniform / Zipfian lookups)\n";
+        cout << "8. Exit\n";
         cout << "Enter choice: ";
         cin >> choice;
 
@@ -229,13 +301,21 @@ int main() {
                 cout << "Enter meaning: ";
                 cin.ignore();
                 getline(cin, meaning);
-                root = insert(root, key, meaning);
+                {
+                    OpTimer timer(dictStats);
+                    root = insert(root, key, meaning);
+                    timer.finish(OP_INSERT, treeHeight);
+                }
                 break;
 
             case 2:
                 cout << "Enter keyword to delete: ";
                 cin >> key;
-                root = deleteNode(root, key);
+                {
+                    OpTimer timer(dictStats);
+                    root = deleteNode(root, key);
+                    timer.finish(OP_DELETE, treeHeight);
+                }
                 break;
 
             case 3:
@@ -257,6 +337,28 @@ int main() {
             }
 
             case 6:
+                cout << "Enter file name for JSON export (or - to print): ";
+                cin >> key;
+                if (key == "-") {
+                    cout << dictStats.toJson();
+                } else if (dictStats.exportJson(key)) {
+                    cout << "Statistics written to " << key << endl;
+                } else {
+                    cout << "Could not write " << key << endl;
+                }
+                break;
+
+            case 7: {
+                int n, style;
+                cout << "Enter number of keys to benchmark: ";
+                cin >> n;
+                cout << "Key style (1 = random words, 2 = prefix-sharing terms): ";
+                cin >> style;
+                if (n > 0) benchmark(n, style == 2);
+                break;
+            }
+
+            case 8:
                 cout << "Exiting...\n";
                 break;
 
@@ -264,7 +366,7 @@ int main() {
                 cout << "Invalid choice!\n";
         }
 
-    } while (choice != 6);
+    } while (choice != 8);
 
     return 0;
 }
@@ -329,6 +431,14 @@ for traversal (Asc/Desc) it is O(n) for all best, avg, worst
 11. Comparison Counting:
     - Tracks number of comparisons during search.
     - Useful to measure performance or efficiency.
+    - dictionary_stats.h (shared with the BST dictionary) additionally records
+      comparisons and a nanosecond latency histogram for every insert, search
+      and delete, the number of rotations, and the tree height over time.
+      Menu option 6 prints these as JSON or writes them to a file.
+    - Menu option 7 times uniform and Zipfian lookups on generated keys; the
+      BST dictionary runs the same workloads for its BST, B-Tree, splay and
+      radix tree modes, so the ns/lookup, comparisons/lookup and bytes/key
+      figures can be put side by side.
 
 12. Menu-Driven Program:
     - Allows interactive operations:
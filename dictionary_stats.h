@@ -0,0 +1,225 @@
+// Shared instrumentation for the dictionary programs
+// (5. Dictionary BST.cpp and 9. Dictionary (AVL TREE).cpp).
+//
+// Records, per operation type, the number of key comparisons and a latency
+// histogram in nanoseconds, plus rotations performed and the tree height
+// over time. Everything can be exported as JSON.
+//
+// Also holds the benchmark workloads (generated keys, uniform and Zipfian
+// lookup sequences) so both programs measure exactly the same input.
+#ifndef DICTIONARY_STATS_H
+#define DICTIONARY_STATS_H
+
+#include <chrono>       // For nanosecond timing
+#include <cmath>        // For pow in the Zipf distribution
+#include <cstdint>      // For fixed width counters
+#include <algorithm>    // For upper_bound and shuffle
+#include <fstream>      // For exporting JSON to a file
+#include <random>       // For benchmark workloads
+#include <sstream>      // For building the JSON text
+#include <string>
+#include <utility>      // For pair
+#include <vector>       // For height samples
+
+// Operation types tracked separately
+enum DictOp { OP_INSERT, OP_SEARCH, OP_DELETE, OP_COUNT };
+
+const char* const DICT_OP_NAMES[OP_COUNT] = {"insert", "search", "delete"};
+
+// Latency histogram with power-of-two buckets: bucket i counts operations
+// that took [2^i, 2^(i+1)) ns (bucket 0 also holds 0 ns)
+struct LatencyHistogram {
+    static const int BUCKETS = 40;          // 2^40 ns ~ 18 minutes, plenty
+    uint64_t bucket[BUCKETS] = {0};
+    uint64_t count = 0;                     // Operations recorded
+    uint64_t totalNs = 0;                   // Sum of latencies
+    uint64_t maxNs = 0;                     // Slowest operation
+    uint64_t totalComparisons = 0;          // Sum of key comparisons
+    uint64_t maxComparisons = 0;            // Most comparisons in one operation
+
+    void record(uint64_t ns, uint64_t comparisons) {
+        int b = 0;
+        while (b < BUCKETS - 1 && (ns >> (b + 1)) != 0) b++; // floor(log2(ns))
+        bucket[b]++;
+        count++;
+        totalNs += ns;
+        if (ns > maxNs) maxNs = ns;
+        totalComparisons += comparisons;
+        if (comparisons > maxComparisons) maxComparisons = comparisons;
+    }
+};
+
+// Statistics for one dictionary instance
+struct DictionaryStats {
+    static const size_t MAX_HEIGHT_SAMPLES = 1024;
+
+    std::string structure = "dictionary";   // Name printed in the JSON
+    LatencyHistogram ops[OP_COUNT];
+    uint64_t comparisons = 0;               // Comparisons of the operation in progress
+    uint64_t rotations = 0;                 // Rotations performed since start
+    uint64_t operations = 0;                // Operations recorded since start
+    uint64_t heightInterval = 1;            // Sample the height every this many operations
+    std::vector<std::pair<uint64_t, int>> heightSamples; // (operation number, height)
+
+    // True if the next recorded operation should carry a height sample.
+    // Lets callers skip computing the height when it is expensive (O(n) for a BST).
+    bool wantHeight() const {
+        return (operations + 1) % heightInterval == 0;
+    }
+
+    // Record a finished operation; height is ignored unless wantHeight() was true
+    void record(DictOp op, uint64_t ns, int height) {
+        bool sample = wantHeight();
+        ops[op].record(ns, comparisons);
+        comparisons = 0;
+        operations++;
+        if (!sample) return;
+        heightSamples.push_back(std::make_pair(operations, height));
+        if (heightSamples.size() >= MAX_HEIGHT_SAMPLES) {
+            // Keep every other sample and halve the sampling rate,
+            // so memory stays bounded while covering the whole history
+            size_t j = 0;
+            for (size_t i = 1; i < heightSamples.size(); i += 2) heightSamples[j++] = heightSamples[i];
+            heightSamples.resize(j);
+            heightInterval *= 2;
+        }
+    }
+
+    std::string toJson() const {
+        std::ostringstream out;
+        out << "{\n  \"structure\": \"" << structure << "\",\n";
+        out << "  \"operations\": " << operations << ",\n";
+        out << "  \"rotations\": " << rotations << ",\n";
+        for (int op = 0; op < OP_COUNT; op++) {
+            const LatencyHistogram& h = ops[op];
+            out << "  \"" << DICT_OP_NAMES[op] << "\": {\"count\": " << h.count
+                << ", \"comparisons_total\": " << h.totalComparisons
+                << ", \"comparisons_max\": " << h.maxComparisons
+                << ", \"comparisons_avg\": " << (h.count ? (double)h.totalComparisons / h.count : 0.0)
+                << ", \"latency_ns_total\": " << h.totalNs
+                << ", \"latency_ns_max\": " << h.maxNs
+                << ", \"latency_ns_avg\": " << (h.count ? (double)h.totalNs / h.count : 0.0)
+                << ", \"latency_histogram\": [";
+            bool first = true;
+            for (int b = 0; b < LatencyHistogram::BUCKETS; b++) {
+                if (h.bucket[b] == 0) continue;      // Only non-empty buckets
+                out << (first ? "" : ", ") << "{\"upper_ns\": " << (1ULL << (b + 1))
+                    << ", \"count\": " << h.bucket[b] << "}";
+                first = false;
+            }
+            out << "]},\n";
+        }
+        out << "  \"height_samples\": [";
+        for (size_t i = 0; i < heightSamples.size(); i++) {
+            out << (i ? ", " : "") << "[" << heightSamples[i].first << ", " << heightSamples[i].second << "]";
+        }
+        out << "]\n}\n";
+        return out.str();
+    }
+
+    bool exportJson(const std::string& path) const {
+        std::ofstream file(path);
+        if (!file) return false;
+        file << toJson();
+        return (bool)file;
+    }
+};
+
+// Times one operation: construct before the operation, call finish() after.
+// The height callback runs after the clock is stopped and only when a
+// height sample is due, so an O(n) height walk never skews the latency.
+struct OpTimer {
+    DictionaryStats& stats;
+    std::chrono::steady_clock::time_point start;
+
+    explicit OpTimer(DictionaryStats& s) : stats(s), start(std::chrono::steady_clock::now()) {
+        stats.comparisons = 0;              // Count only this operation's comparisons
+    }
+
+    template <class HeightFn>
+    void finish(DictOp op, HeightFn height) {
+        uint64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                          std::chrono::steady_clock::now() - start).count();
+        stats.record(op, ns, stats.wantHeight() ? height() : 0);
+    }
+};
+
+// Generate the i-th benchmark keyword: distinct, 14 lowercase letters,
+// in a scrambled order so trees receive random (not sorted) input
+inline std::string benchmarkKey(uint64_t i) {
+    uint64_t z = i + 0x9E3779B97F4A7C15ULL;             // SplitMix64 finaliser (a bijection)
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    z = z ^ (z >> 31);
+    std::string key(14, 'a');
+    for (int j = 13; j >= 0; j--) {                     // Base-26 digits of z
+        key[j] = 'a' + z % 26;
+        z /= 26;
+    }
+    return key;
+}
+
+// Generate the i-th prefix-sharing "technical term": one of 16 long stems
+// followed by 14 letters. Distinct for distinct i (the stem and the letters
+// together encode one bijectively scrambled 64-bit value).
+inline std::string benchmarkTerm(uint64_t i) {
+    static const char* const STEMS[16] = {
+        "electromagnetic", "thermodynamic", "photosynthetic", "neurotransmitter",
+        "immunoglobulin", "spectrophotometric", "microarchitecture", "electrocardiographic",
+        "hydrodynamical", "superconducting", "biogeochemical", "magnetohydrodynamic",
+        "crystallographic", "phosphorylation", "interferometric", "chromatographic"};
+    uint64_t z = i + 0x9E3779B97F4A7C15ULL;             // Same bijection as benchmarkKey
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    z = z ^ (z >> 31);
+    std::string key = STEMS[z % 16];
+    z /= 16;
+    std::string tail(14, 'a');
+    for (int j = 13; j >= 0; j--) {
+        tail[j] = 'a' + z % 26;
+        z /= 26;
+    }
+    return key + "-" + tail;
+}
+
+// Heap bytes owned by a string (0 when the text fits in the string object
+// itself thanks to the small-string optimisation)
+inline size_t stringHeapBytes(const std::string& str) {
+    const char* data = str.data();
+    const char* self = (const char*)&str;
+    if (data >= self && data < self + sizeof(str)) return 0;
+    return str.capacity() + 1;
+}
+
+// Sequence of `count` lookups into keys 0..n-1 (indices into benchmarkKey).
+// Uniform: every key equally likely. Zipfian: the key of popularity rank r is
+// drawn with probability proportional to 1/r^s. Ranks are assigned to keys by
+// a fixed random permutation, so the hot keys are not simply the ones that
+// happened to be inserted first.
+inline std::vector<int> benchmarkLookups(int n, int count, bool zipf, double s = 1.0) {
+    std::mt19937_64 rng(2024);
+    std::vector<int> rankToKey(n);
+    for (int i = 0; i < n; i++) rankToKey[i] = i;
+    std::shuffle(rankToKey.begin(), rankToKey.end(), rng);
+
+    std::vector<int> lookups(count);
+    if (!zipf) {
+        std::uniform_int_distribution<int> pick(0, n - 1);
+        for (int i = 0; i < count; i++) lookups[i] = pick(rng);
+        return lookups;
+    }
+    std::vector<double> cdf(n);                         // Cumulative popularity of ranks 1..n
+    double sum = 0;
+    for (int r = 0; r < n; r++) {
+        sum += 1.0 / std::pow(r + 1.0, s);
+        cdf[r] = sum;
+    }
+    std::uniform_real_distribution<double> u(0.0, sum);
+    for (int i = 0; i < count; i++) {
+        int r = std::upper_bound(cdf.begin(), cdf.end(), u(rng)) - cdf.begin();
+        lookups[i] = rankToKey[r < n ? r : n - 1];
+    }
+    return lookups;
+}
+
+#endif